@@ -6,6 +6,13 @@
 */
 #include "mbed.h"
 #include "N5110.h"
+#ifdef TARGET_CORTEX_M
+#ifndef TARGET_LPC1768
+#error "refreshAsync() drives the GPDMA and the SSP of the LPC1768"
+#endif
+#else
+#include <sched.h>
+#endif
 
 
 N5110::N5110(PinName pwrPin, PinName scePin, PinName rstPin, PinName dcPin, PinName mosiPin, PinName sclkPin, PinName ledPin)
@@ -13,6 +20,8 @@ N5110::N5110(PinName pwrPin, PinName scePin, PinName rstPin, PinName dcPin, PinN
     
     spi = new SPI(mosiPin,NC,sclkPin); // create new SPI instance and initialise
     initSPI();    
+    mosi = mosiPin;
+    sclk = sclkPin;
     
     // set up pins as required
     led = new PwmOut(ledPin);
@@ -21,6 +30,19 @@ N5110::N5110(PinName pwrPin, PinName scePin, PinName rstPin, PinName dcPin, PinN
     rst = new DigitalOut(rstPin);
     dc = new DigitalOut(dcPin);
 
+    spiBytes = 0;
+    addressX = addressY = 0;
+    for (int j = 0; j < 6; j++) {  // the whole buffer is compared by the first refresh
+        dirtyFirst[j] = 0;
+        dirtyLast[j] = 83;
+    }
+    memset(shadow,0,sizeof(shadow));  // RAM is undefined until init() clears it
+
+    busy = false;
+    txCount = txNext = txOffset = 0;
+    txDone = NULL;
+    initDMA();
+
 }
 
 // initialise function - powers up and sends the initialisation commands
@@ -102,21 +124,23 @@ void N5110::reset()
 {
     rst->write(0);  // reset the LCD
     rst->write(1);
+    addressX = addressY = 0;  // the reset sets the address to 0,0
 }
 
 // function to initialise SPI peripheral
 void N5110::initSPI()
 {
     spi->format(8,1);    // 8 bits, Mode 1 - polarity 0, phase 1 - base value of clock is 0, data captured on falling edge/propagated on rising edge
-    spi->frequency(4000000);  // maximum of screen is 4 MHz
+    spi->frequency(N5110_SPI_FREQUENCY);  // maximum of screen is 4 MHz
 }
 
 // send a command to the display
 void N5110::sendCommand(unsigned char command)
 {
+    waitRefresh();  // the asynchronous refresh owns the bus
     dc->write(0);  // set DC low for command
     sce->write(0); // set CE low to begin frame
-    spi->write(command);  // send command
+    writeSPI(command);  // send command
     dc->write(1);  // turn back to data by default
     sce->write(1); // set CE high to end frame (expected for transmission of single byte)
 
@@ -127,20 +151,50 @@ void N5110::sendCommand(unsigned char command)
 // be the default mode.
 void N5110::sendData(unsigned char data)
 {
+    waitRefresh();  // the asynchronous refresh owns the bus
     sce->write(0);   // set CE low to begin frame
-    spi->write(data);
+    writeSPI(data);
     sce->write(1);  // set CE high to end frame (expected for transmission of single byte)
+
+    // the RAM no longer matches the buffer, so the column is compared by the next refresh
+    shadow[addressX][addressY] = data;
+    markDirty(addressX,addressX,addressY);
+
+    // horizontal addressing - X is incremented and wraps to the next bank
+    if (++addressX == 84) {
+        addressX = 0;
+        addressY = (addressY + 1) % 6;
+    }
+}
+
+// write a byte over SPI and count it
+void N5110::writeSPI(unsigned char byte)
+{
+    spi->write(byte);
+    spiBytes++;
+}
+
+// returns the number of bytes sent to the display
+unsigned long N5110::getSPIBytes()
+{
+    return spiBytes;
 }
 
 // this function writes 0 to the 504 bytes to clear the RAM
 void N5110::clearRAM()
 {
     int i;
+    waitRefresh();  // the asynchronous refresh owns the bus
     sce->write(0);  //set CE low to begin frame
     for(i = 0; i < 504; i++) { // 48 x 84 bits = 504 bytes
-        spi->write(0x00);  // send 0's
+        writeSPI(0x00);  // send 0's
     }
     sce->write(1); // set CE high to end frame
+    // the address wraps back to where it was, and the RAM no longer matches the buffer
+    memset(shadow,0,sizeof(shadow));
+    for(i = 0; i < 6; i++) {
+        markDirty(0,83,i);
+    }
 
 }
 
@@ -159,6 +213,38 @@ void N5110::setXYAddress(int x, int y)
 
     sendCommand(0x80 | x);  // send addresses to display with relevant mask
     sendCommand(0x40 | y);
+    addressX = x;
+    addressY = y;
+}
+
+// sends the XY address without waiting for the asynchronous refresh, which calls it
+void N5110::sendAddress(int x, int y)
+{
+    dc->write(0);  // set DC low for command
+    sce->write(0); // set CE low to begin frame
+    writeSPI(0x80 | x);  // send addresses to display with relevant mask
+    writeSPI(0x40 | y);
+    dc->write(1);  // turn back to data by default
+    sce->write(1); // set CE high to end frame
+    addressX = x;
+    addressY = y;
+}
+
+// marks columns x0 to x1 of a bank as modified since the last refresh
+void N5110::markDirty(int x0, int x1, int bank)
+{
+    // check whether range is on the display
+    if (x0 < 0)
+        x0=0;
+    if (x1 > 83)
+        x1=83;
+    if (x0 > x1 || bank < 0 || bank > 5)
+        return;
+
+    if (x0 < dirtyFirst[bank] || dirtyFirst[bank] > dirtyLast[bank])
+        dirtyFirst[bank] = x0;
+    if (x1 > dirtyLast[bank])
+        dirtyLast[bank] = x1;
 }
 
 // These functions are used to set, clear and get the value of pixels in the display
@@ -168,12 +254,14 @@ void N5110::setPixel(int x, int y)
 {
     // calculate bank and shift 1 to required position in the data byte
     buffer[x][y/8] |= (1 << y%8);
+    markDirty(x,x,y/8);
 }
 
 void N5110::clearPixel(int x, int y)
 {
     // calculate bank and shift 1 to required position (using bit clear)
     buffer[x][y/8] &= ~(1 << y%8);
+    markDirty(x,x,y/8);
 }
 
 int N5110::getPixel(int x, int y)
@@ -183,24 +271,293 @@ int N5110::getPixel(int x, int y)
 
 }
 
-// function to refresh the display
+// function to refresh the display - the buffer is compared with the shadow of the
+// display RAM in the modified columns, and only the bytes that differ are sent
 void N5110::refresh()
 {
     int i,j;
-    
-    setXYAddress(0,0);  // important to set address back to 0,0 before refreshing display
-    // address auto increments after printing string, so buffer[0][0] will not coincide
-    // with top-left pixel after priting string
-    
-    sce->write(0);  //set CE low to begin frame
+    int full = 504 + ((addressX != 0 || addressY != 0) ? 2 : 0);  // bytes of a full write
+
+    waitRefresh();
+    if (sendRuns(COUNT_RUNS) < full) {
+        sendRuns(SEND_RUNS);  // the runs are shorter
+    } else {
+        if (addressX != 0 || addressY != 0)
+            setXYAddress(0,0);  // important to set address back to 0,0 before a full write
+        sce->write(0);  //set CE low to begin frame
+        for(j = 0; j < 6; j++) {  // be careful to use correct order (j,i) for horizontal addressing
+            for(i = 0; i < 84; i++) {
+                writeSPI(buffer[i][j]);  // send buffer
+                shadow[i][j] = buffer[i][j];
+            }
+        }
+        sce->write(1); // set CE high to end frame
+        // the address wraps back to 0,0
+    }
 
-    for(j = 0; j < 6; j++) {  // be careful to use correct order (j,i) for horizontal addressing
-        for(i = 0; i < 84; i++) {
-            spi->write(buffer[i][j]);  // send buffer
+    for(j = 0; j < 6; j++) {
+        dirtyFirst[j] = 84;  // none
+        dirtyLast[j] = -1;
+    }
+
+    // important to set address back to 0,0 after refreshing display, printChar()
+    // prints at the current address
+    if (addressX != 0 || addressY != 0)
+        setXYAddress(0,0);
+
+}
+
+// function to refresh the display by DMA - the runs are found as by refresh() and
+// copied to txData with the shadow updated, then they are sent one after the other
+// by startRun() and the DMA interrupt
+void N5110::refreshAsync(void (*done)(void))
+{
+    int i,j;
+    int full = 504 + ((addressX != 0 || addressY != 0) ? 2 : 0);  // bytes of a full write
+
+    waitRefresh();  // the previous transfer still reads txData
+    txCount = 0;
+    txOffset = 0;
+    if (sendRuns(COUNT_RUNS) < full) {
+        sendRuns(QUEUE_RUNS);  // the runs are shorter
+    } else {
+        txRuns[0].x = (addressX != 0 || addressY != 0) ? 0 : 0xFF;
+        txRuns[0].y = 0;
+        txRuns[0].length = 504;
+        txCount = 1;
+        for(j = 0; j < 6; j++) {  // be careful to use correct order (j,i) for horizontal addressing
+            for(i = 0; i < 84; i++) {
+                txData[j*84 + i] = buffer[i][j];
+                shadow[i][j] = buffer[i][j];
+            }
+        }
+    }
+
+    for(j = 0; j < 6; j++) {
+        dirtyFirst[j] = 84;  // none
+        dirtyLast[j] = -1;
+    }
+
+    if (txCount == 0) {  // nothing changed
+        if (done)
+            done();
+        return;
+    }
+    txNext = 0;
+    txOffset = 0;
+    txDone = done;
+    busy = true;
+    startRun();
+}
+
+// returns true while an asynchronous refresh is in progress
+bool N5110::isRefreshing()
+{
+    return busy;
+}
+
+// waits for the asynchronous refresh - the transfer is driven by the DMA interrupt, so
+// it completes while this spins
+void N5110::waitRefresh()
+{
+    while (busy) {
+#ifndef TARGET_CORTEX_M
+        sched_yield();  // the simulated DMA is a thread of the host
+#endif
+    }
+}
+
+// finds the runs of bytes that differ from the shadow in the modified columns, in the
+// order of horizontal addressing, and counts, sends or queues them depending on mode.
+// Runs less than 3 bytes apart are joined, since setting the address takes 2 bytes.
+// Returns the number of bytes (data and addresses) of the runs.
+int N5110::sendRuns(int mode)
+{
+    int i,j,k;
+    int start = -1, end = -1;  // current run, bank*84 + column
+
+    runAddress = addressY*84 + addressX;
+    runBytes = 0;
+    for(j = 0; j < 6; j++) {
+        for(i = dirtyFirst[j]; i <= dirtyLast[j]; i++) {
+            if (buffer[i][j] == shadow[i][j])
+                continue;
+            k = j*84 + i;
+            if (start >= 0 && k - end > 3) {
+                sendRun(start,end,mode);  // gap too long, close the run
+                start = -1;
+            }
+            if (start < 0)
+                start = k;
+            end = k;
         }
     }
+    if (start >= 0)
+        sendRun(start,end,mode);
+    return runBytes;
+}
+
+// counts, sends or queues buffer bytes start to end (bank*84 + column), setting the
+// address only if it doesn't follow on from the previous run
+void N5110::sendRun(int start, int end, int mode)
+{
+    int k;
+    bool follows = (start == runAddress);
+
+    runBytes += end - start + 1 + (follows ? 0 : 2);
+    runAddress = (end + 1) % 504;
+
+    if (mode == QUEUE_RUNS) {
+        Run &r = txRuns[txCount++];
+        r.x = follows ? 0xFF : start % 84;
+        r.y = start / 84;
+        r.length = end - start + 1;
+        for(k = start; k <= end; k++) {
+            txData[txOffset++] = buffer[k % 84][k / 84];
+            shadow[k % 84][k / 84] = buffer[k % 84][k / 84];
+        }
+    } else if (mode == SEND_RUNS) {
+        if (!follows)
+            setXYAddress(start % 84,start / 84);
+        sce->write(0);  //set CE low to begin frame
+        for(k = start; k <= end; k++) {
+            writeSPI(buffer[k % 84][k / 84]);  // send buffer
+            shadow[k % 84][k / 84] = buffer[k % 84][k / 84];
+        }
+        sce->write(1); // set CE high to end frame
+
+        // horizontal addressing - X is incremented and wraps to the next bank
+        addressX = (end + 1) % 84;
+        addressY = ((end + 1) / 84) % 6;
+    }
+}
+
+// starts sending the next queued run, or completes the asynchronous refresh -
+// called by refreshAsync() and then from the DMA interrupt
+void N5110::startRun()
+{
+    if (txNext == txCount) {
+        // important to set address back to 0,0 after refreshing display
+        if (addressX != 0 || addressY != 0)
+            sendAddress(0,0);
+        busy = false;
+        if (txDone)
+            txDone();
+        return;
+    }
+
+    Run &r = txRuns[txNext];
+    if (r.x != 0xFF)
+        sendAddress(r.x,r.y);
+    sce->write(0);  //set CE low to begin frame, the DMA sends the data
+    startDMA(txData + txOffset,r.length);
+}
+
+// ends the frame of the run sent by the DMA, once the SPI is idle
+void N5110::endDMA()
+{
+#ifdef TARGET_CORTEX_M
+    LPC_SSP_TypeDef *ssp = (mosi == p5) ? LPC_SSP1 : LPC_SSP0;
+    while (ssp->SR & (1 << 4)) {  // BSY - the last bytes are still shifted out of the FIFO
+    }
+    while (ssp->SR & (1 << 2)) {  // RNE - drop the bytes received meanwhile
+        (void) ssp->DR;
+    }
+    ssp->ICR = 1;  // clear the receive overrun
+#endif
     sce->write(1); // set CE high to end frame
+}
+
+// end of the DMA transfer of a run (DMA interrupt)
+void N5110::dmaDone()
+{
+    Run &r = txRuns[txNext++];
+
+    endDMA();
+    spiBytes += r.length;
+
+    // horizontal addressing - X is incremented and wraps to the next bank
+    int k = addressY*84 + addressX + r.length;
+    addressX = k % 84;
+    addressY = (k / 84) % 6;
+    txOffset += r.length;
+
+    startRun();
+}
+
+// error of the DMA transfer of a run (DMA interrupt) - the bytes that reached the
+// display RAM and its address are unknown, so the remaining runs are dropped and the
+// shadow is invalidated, i.e. the next refresh rewrites the whole display
+void N5110::dmaError()
+{
+    int i,j;
 
+    endDMA();
+    for(j = 0; j < 6; j++) {
+        for(i = 0; i < 84; i++) {
+            shadow[i][j] = ~buffer[i][j];
+        }
+        markDirty(0,83,j);
+    }
+    sendAddress(0,0);
+    txNext = txCount;
+    startRun();  // completes the asynchronous refresh
+}
+
+#ifdef TARGET_CORTEX_M
+
+N5110 *N5110::dmaDisplay = NULL;
+
+// DMA interrupt - the terminal count or an error of the channel
+void N5110::dmaIRQ()
+{
+    if (LPC_GPDMA->DMACIntErrStat & (1 << N5110_DMA_CHANNEL)) {
+        LPC_GPDMA->DMACIntErrClr = 1 << N5110_DMA_CHANNEL;
+        LPC_GPDMA->DMACIntTCClear = 1 << N5110_DMA_CHANNEL;
+        dmaDisplay->dmaError();  // the channel is disabled by the error
+    } else if (LPC_GPDMA->DMACIntTCStat & (1 << N5110_DMA_CHANNEL)) {
+        LPC_GPDMA->DMACIntTCClear = 1 << N5110_DMA_CHANNEL;
+        dmaDisplay->dmaDone();
+    }
+}
+
+#endif
+
+// sets up the DMA to the SPI transmit FIFO - GPDMA on the LPC1768, the simulated
+// DMA of the simulator on the host
+void N5110::initDMA()
+{
+#ifdef TARGET_CORTEX_M
+    LPC_SSP_TypeDef *ssp = (mosi == p5) ? LPC_SSP1 : LPC_SSP0;
+    LPC_SC->PCONP |= 1 << 29;    // power up the GPDMA
+    LPC_GPDMA->DMACConfig = 1;   // enable, little-endian
+    ssp->DMACR |= 1 << 1;        // TXDMAE - the transmit FIFO requests DMA
+    dmaDisplay = this;
+    NVIC_SetVector(DMA_IRQn,(uint32_t) &N5110::dmaIRQ);
+    NVIC_EnableIRQ(DMA_IRQn);
+#else
+    dmaCallback.attach(this,&N5110::dmaDone);
+#endif
+}
+
+// starts the DMA transfer of length bytes to the SPI transmit FIFO
+void N5110::startDMA(const unsigned char *data, int length)
+{
+#ifdef TARGET_CORTEX_M
+    LPC_GPDMACH_TypeDef *ch = (LPC_GPDMACH_TypeDef *) (LPC_GPDMACH0_BASE + 0x20*N5110_DMA_CHANNEL);
+    LPC_SSP_TypeDef *ssp = (mosi == p5) ? LPC_SSP1 : LPC_SSP0;
+    int request = (mosi == p5) ? 2 : 0;  // SSP1 Tx or SSP0 Tx
+
+    ch->DMACCSrcAddr = (uint32_t) data;
+    ch->DMACCDestAddr = (uint32_t) &ssp->DR;
+    ch->DMACCLLI = 0;
+    // transfer size, bursts of 1 byte, source increment, terminal count interrupt
+    ch->DMACCControl = length | (1 << 26) | (1UL << 31);
+    // enable, destination request, memory to peripheral, interrupts unmasked
+    ch->DMACCConfig = 1 | (request << 6) | (1 << 11) | (1 << 14) | (1 << 15);
+#else
+    mbed_sim_spi_dma(sclk,data,length,N5110_SPI_FREQUENCY,&dmaCallback);
+#endif
 }
 
 // fills the buffer with random bytes.  Can be used to test the display.
@@ -212,6 +569,7 @@ void N5110::randomiseBuffer()
         for(i = 0; i < 84; i++) {
             buffer[i][j] = rand()%256;  // generate random byte
         }
+        markDirty(0,83,j);
     }
 
 }
@@ -220,6 +578,8 @@ void N5110::randomiseBuffer()
 void N5110::printChar(char c)
 {
     int i;
+    // the character goes straight to the RAM, sendData() updates the shadow so that
+    // the next refresh restores the buffer
     // loop through 5 columns
     for (i = 0; i < 5 ; i++ ) {
         sendData(font5x7[(c - 32)*5 + i]);
@@ -246,6 +606,7 @@ void N5110::printString(const char * str,int x,int y)
         for (int i = 0; i < 5 ; i++ ) {
             buffer[x+i+n*6][y] = font5x7[(*str - 32)*5 + i];
         }
+        markDirty(x+n*6,x+n*6+4,y);
         
         str++;  // go to next character in string
         n++;    // increment index
@@ -268,7 +629,10 @@ void N5110::clearBuffer()
     int i,j;
     for (i=0; i<84; i++) {  // loop through the banks and set the buffer to 0
         for (j=0; j<6; j++) {
-            buffer[i][j]=0;
+            if (buffer[i][j]) {  // only the columns that were set need sending
+                buffer[i][j]=0;
+                markDirty(i,i,j);
+            }
         }
     }
 }
@@ -289,3 +653,172 @@ void N5110::plotArray(float array[]) {
     
 
 }
+
+// function to draw a line (Bresenham) - steep lines are drawn as one vertical span per
+// column, so the cost is per byte of the column rather than per pixel
+void N5110::drawLine(int x0, int y0, int x1, int y1)
+{
+    int dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+    int dy = (y1 > y0) ? y1 - y0 : y0 - y1;
+    int sx = (x1 > x0) ? 1 : -1;
+    int sy = (y1 > y0) ? 1 : -1;
+    int err, x, y;
+
+    if (dy > dx) {  // steep - y is stepped, x changes at most once per step
+        err = dy / 2;
+        x = x0;
+        int span = y0;  // first y of the span of column x
+        for (y = y0; y != y1; y += sy) {
+            err -= dx;
+            if (err < 0) {  // next pixel is in the next column, close the span
+                drawVLine(x,span,y);
+                x += sx;
+                err += dy;
+                span = y + sy;
+            }
+        }
+        drawVLine(x,span,y1);
+    } else {  // shallow - one pixel per column
+        err = dx / 2;
+        y = y0;
+        for (x = x0; ; x += sx) {
+            if (x >= 0 && x < 84 && y >= 0 && y < 48)
+                setPixel(x,y);
+            if (x == x1)
+                break;
+            err -= dy;
+            if (err < 0) {
+                y += sy;
+                err += dx;
+            }
+        }
+    }
+}
+
+// function to draw a vertical line
+void N5110::drawVLine(int x, int y0, int y1)
+{
+    fillSpan(x,y0,y1,true);
+}
+
+// sets (or clears) pixels y0 to y1 of a column - the bytes of the column are written
+// with masks
+void N5110::fillSpan(int x, int y0, int y1, bool set)
+{
+    int j;
+
+    if (y0 > y1) {  // y0 is the top
+        j = y0;
+        y0 = y1;
+        y1 = j;
+    }
+    // check whether span is on the display
+    if (y0 < 0)
+        y0=0;
+    if (y1 > 47)
+        y1=47;
+    if (x < 0 || x > 83 || y0 > y1)
+        return;
+
+    int first = y0 >> 3, last = y1 >> 3;  // banks
+    unsigned char top = 0xFF << (y0 & 7);  // bits y0 and below in the first bank
+    unsigned char bottom = 0xFF >> (7 - (y1 & 7));  // bits y1 and above in the last bank
+
+    for (j = first; j <= last; j++) {
+        unsigned char mask = 0xFF;
+        if (j == first)
+            mask &= top;
+        if (j == last)
+            mask &= bottom;
+        if (set)
+            buffer[x][j] |= mask;
+        else
+            buffer[x][j] &= ~mask;
+    }
+    for (j = first; j <= last; j++) {
+        markDirty(x,x,j);
+    }
+}
+
+// function to draw a horizontal line
+void N5110::drawHLine(int x0, int x1, int y)
+{
+    int i;
+
+    if (x0 > x1) {  // x0 is the left end
+        i = x0;
+        x0 = x1;
+        x1 = i;
+    }
+    // check whether line is on the display
+    if (x0 < 0)
+        x0=0;
+    if (x1 > 83)
+        x1=83;
+    if (y < 0 || y > 47 || x0 > x1)
+        return;
+
+    unsigned char mask = 1 << (y & 7);
+    for (i = x0; i <= x1; i++) {
+        buffer[i][y >> 3] |= mask;
+    }
+    markDirty(x0,x1,y >> 3);
+}
+
+// function to draw a rectangle, filled with vertical spans or as an outline
+void N5110::drawRect(int x, int y, int w, int h, bool fill)
+{
+    int i;
+
+    if (w <= 0 || h <= 0)
+        return;
+
+    if (fill) {
+        for (i = x; i < x + w; i++) {
+            drawVLine(i,y,y + h - 1);
+        }
+    } else {
+        drawHLine(x,x + w - 1,y);
+        drawHLine(x,x + w - 1,y + h - 1);
+        drawVLine(x,y,y + h - 1);
+        drawVLine(x + w - 1,y,y + h - 1);
+    }
+}
+
+// function to clear a rectangle with vertical spans
+void N5110::clearRect(int x, int y, int w, int h)
+{
+    int i;
+
+    if (w <= 0 || h <= 0)
+        return;
+    for (i = x; i < x + w; i++) {
+        fillSpan(i,y,y + h - 1,false);
+    }
+}
+
+// function to draw a string at any pixel position - each font column is shifted
+// across the two banks of the row
+void N5110::drawString(const char *str, int x, int y)
+{
+    int shift = y & 7;  // bits below the top of the bank
+    int bank = y >> 3;  // bank of the top row (negative above the display)
+
+    for (; *str; str++, x += 6) {  // leave 1 pixel (6 = 5 + 1) between each character
+        if (*str < 32 || *str > 127)
+            continue;  // not in the font
+        for (int i = 0; i < 5; i++) {
+            if (x + i < 0 || x + i > 83)
+                continue;
+            unsigned char bits = font5x7[(*str - 32)*5 + i];
+            if (bank >= 0 && bank < 6) {
+                buffer[x+i][bank] |= bits << shift;
+                markDirty(x+i,x+i,bank);
+            }
+            if (shift && bank + 1 >= 0 && bank + 1 < 6) {
+                buffer[x+i][bank+1] |= bits >> (8 - shift);
+                markDirty(x+i,x+i,bank+1);
+            }
+        }
+    }
+}
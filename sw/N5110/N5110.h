@@ -32,6 +32,16 @@
 #define CMD_VOP_6V06           0xB2
 #define CMD_VOP_7V38           0xC8
 
+// SPI clock - maximum of screen is 4 MHz
+#define N5110_SPI_FREQUENCY    4000000
+
+// Runs of bytes queued by refreshAsync() - runs less than 3 bytes apart are joined,
+// so there are at most 504/4 of them
+#define N5110_MAX_RUNS         126
+
+// GPDMA channel of refreshAsync() on the LPC1768 - channel 7 has the lowest priority
+#define N5110_DMA_CHANNEL      7
+
 #include "mbed.h"
 
 /** 
@@ -129,6 +139,13 @@ public:
     */
     void clear();
     
+    /** Clear buffer
+    *
+    *   Clears the buffer without refreshing the display, e.g. before drawing the next frame.
+    *   A call to refresh() must be made to update the display.
+    */
+    void clearBuffer();
+    
     /** Turn on normal video mode (default)
     *  Black on white
     */
@@ -202,9 +219,49 @@ public:
     /** Refresh display
     *
     *   This functions refreshes the display to reflect the current data in the buffer.
+    *   Only the bytes that differ from the display RAM are sent, as runs of consecutive
+    *   addresses, or the whole buffer if that is shorter.
     */    
     void refresh();
     
+    /** Refresh display asynchronously
+    *
+    *   Starts refreshing the display like refresh() and returns while the bytes are sent by
+    *   DMA. The bytes to send are copied, so the next frame can be drawn into the buffer
+    *   during the transfer. The functions that write to the display wait for the transfer.
+    *   @param  done - function called once the display is refreshed, from the DMA
+    *                  interrupt (or at once if nothing changed), or NULL
+    */
+    void refreshAsync(void (*done)(void) = NULL);
+    
+    /** Is refreshing
+    *
+    *   @returns true while an asynchronous refresh is in progress
+    */
+    bool isRefreshing();
+    
+    /** Wait for refresh
+    *
+    *   Waits until the asynchronous refresh (if any) is complete.
+    */
+    void waitRefresh();
+    
+    /** Mark buffer as modified
+    *
+    *   Marks columns x0 to x1 of a bank as modified, so that the next refresh() sends them.
+    *   Must be called after writing to buffer directly (setPixel() and the other functions do it).
+    *   @param  x0 - the first column (0 to 83)
+    *   @param  x1 - the last column (0 to 83)
+    *   @param  bank - the bank (0 to 5)
+    */
+    void markDirty(int x0, int x1, int bank);
+    
+    /** Get SPI byte count
+    *
+    *   Returns the number of bytes (commands and data) sent to the display since it was created.
+    */
+    unsigned long getSPIBytes();
+    
     /** Randomise buffer
     *
     *   This function fills the buffer with random data.  Can be used to test the display.  
@@ -222,15 +279,102 @@ public:
     *   plotted. y values in the array should be normalised in the range 0.0 to 1.0. 
     */
     void plotArray(float array[]);
+    
+    /** Draw a Line
+    *
+    *   Draws a line between two pixels (Bresenham). Steep lines are drawn as one vertical
+    *   span per column. Pixels off the display are skipped. A call to refresh() must be
+    *   made to update the display.
+    *   @param  x0 - the x co-ordinate of the first pixel
+    *   @param  y0 - the y co-ordinate of the first pixel
+    *   @param  x1 - the x co-ordinate of the last pixel
+    *   @param  y1 - the y co-ordinate of the last pixel
+    */
+    void drawLine(int x0, int y0, int x1, int y1);
+    
+    /** Draw a Vertical Line
+    *
+    *   Sets pixels y0 to y1 of a column, a whole byte at a time. A call to refresh() must
+    *   be made to update the display.
+    *   @param  x - the x co-ordinate of the column (0 to 83)
+    *   @param  y0 - the y co-ordinate of one end
+    *   @param  y1 - the y co-ordinate of the other end
+    */
+    void drawVLine(int x, int y0, int y1);
+    
+    /** Draw a Horizontal Line
+    *
+    *   Sets pixels x0 to x1 of a row. A call to refresh() must be made to update the display.
+    *   @param  x0 - the x co-ordinate of one end
+    *   @param  x1 - the x co-ordinate of the other end
+    *   @param  y - the y co-ordinate of the row (0 to 47)
+    */
+    void drawHLine(int x0, int x1, int y);
+    
+    /** Draw a Rectangle
+    *
+    *   Draws the outline of a rectangle, or fills it with vertical spans. A call to
+    *   refresh() must be made to update the display.
+    *   @param  x - the x co-ordinate of the top-left pixel
+    *   @param  y - the y co-ordinate of the top-left pixel
+    *   @param  w - the width (pixels)
+    *   @param  h - the height (pixels)
+    *   @param  fill - true to fill the rectangle
+    */
+    void drawRect(int x, int y, int w, int h, bool fill = false);
+    
+    /** Clear a Rectangle
+    *
+    *   Clears the pixels of a rectangle, a whole byte at a time. A call to refresh() must
+    *   be made to update the display.
+    *   @param  x - the x co-ordinate of the top-left pixel
+    *   @param  y - the y co-ordinate of the top-left pixel
+    *   @param  w - the width (pixels)
+    *   @param  h - the height (pixels)
+    */
+    void clearRect(int x, int y, int w, int h);
+    
+    /** Draw String
+    *
+    *   Draws a string with the 5x7 font at any pixel position, into the buffer (unlike
+    *   printString(), the row need not be a bank and the display is not refreshed).
+    *   Characters are 6 pixels apart and the pixels off the display are skipped.
+    *   @param  str - the string
+    *   @param  x - the x co-ordinate of the top-left pixel
+    *   @param  y - the y co-ordinate of the top-left pixel
+    */
+    void drawString(const char *str, int x, int y);
 
 private:
     void initSPI();
     void turnOn();
     void reset();
     void clearRAM();
-    void clearBuffer();
     void sendCommand(unsigned char command);
     void sendData(unsigned char data);
+    void writeSPI(unsigned char byte);
+    void sendAddress(int x, int y);
+    void fillSpan(int x, int y0, int y1, bool set);
+    int sendRuns(int mode);
+    void sendRun(int start, int end, int mode);
+    void initDMA();
+    void startRun();
+    void startDMA(const unsigned char *data, int length);
+    void endDMA();
+    void dmaDone();
+    void dmaError();
+#ifdef TARGET_CORTEX_M
+    static void dmaIRQ();
+    static N5110 *dmaDisplay;  // display of the DMA interrupt
+#endif
+
+    enum { COUNT_RUNS, SEND_RUNS, QUEUE_RUNS };  // modes of sendRuns()
+
+    // run of consecutive bytes queued by refreshAsync()
+    struct Run {
+        unsigned char x, y;     // address, or x = 0xFF if it follows on from the previous run
+        unsigned short length;  // bytes
+    };
 
 public:
     unsigned char buffer[84][6];  // screen buffer - the 6 is for the banks - each one is 8 bits;
@@ -242,6 +386,27 @@ private:  // private variables
     DigitalOut* sce;
     DigitalOut* rst;
     DigitalOut* dc;
+    
+    int dirtyFirst[6];  // first and last modified column of each bank, none if first > last
+    int dirtyLast[6];
+    unsigned char shadow[84][6];  // copy of the display RAM, i.e. what the panel shows
+    int addressX;       // XY address of the display RAM, incremented by each data byte
+    int addressY;
+    int runAddress;     // address of the next run (bank*84 + column), while refreshing
+    int runBytes;       // bytes of the runs, while refreshing
+    unsigned long spiBytes;  // bytes sent to the display
+    
+    PinName mosi, sclk;  // pins of the SPI bus, for the DMA
+    unsigned char txData[504];  // bytes of the queued runs - the buffer of the transfer
+    Run txRuns[N5110_MAX_RUNS];
+    int txCount;         // queued runs
+    int txNext;          // next run to send
+    int txOffset;        // offset of the next run in txData
+    volatile bool busy;  // asynchronous refresh in progress
+    void (*txDone)(void);  // callback of the asynchronous refresh
+#ifndef TARGET_CORTEX_M
+    FunctionPointer dmaCallback;  // of the simulated DMA
+#endif
 
 };
 
@@ -0,0 +1,357 @@
+/* Plot.cpp
+ *
+ * Author: Petros Fountas
+ * Created on Fri 16 Oct 2026
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "Plot.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// true unless v is NaN or infinite (v - v is NaN for both)
+static inline bool finite_value(float v) {
+	return v - v == 0;
+}
+
+// tick step of 1, 2 or 5 x 10^k, for at least ticks steps over span
+static float nice_step(float span, int ticks) {
+
+	float raw = span / ticks;
+	float mag = powf(10, floorf(log10f(raw)));
+	float f = raw / mag;
+	if (f <= 1)
+		return mag;
+	if (f <= 2)
+		return 2 * mag;
+	if (f <= 5)
+		return 5 * mag;
+	return 10 * mag;
+}
+
+Plot::Plot(N5110 *display, int x, int y, int w, int h)
+{
+	this->lcd = display;
+	if (w > PLOT_MAX_WIDTH)
+		w = PLOT_MAX_WIDTH;
+	if (w < PLOT_AXIS_WIDTH + 1)
+		w = PLOT_AXIS_WIDTH + 1;
+	if (h < 2)
+		h = 2;
+	this->x = x;
+	this->y = y;
+	this->w = w;
+	this->h = h;
+	this->lo = 0;
+	this->hi = 1;
+	this->step = 0.25f;
+	this->scaled = false;
+	this->autoscale = true;
+	this->shrink = 0.25f;
+	this->labels = true;
+	this->perColumn = 1;
+	this->sweep = false;
+	this->labelRight = 0;
+	this->clear();
+}
+
+void Plot::setAutoscale(float shrink)
+{
+	this->autoscale = true;
+	this->scaled = false;
+	this->shrink = shrink;
+}
+
+void Plot::setRange(float min, float max)
+{
+	if (!(max > min))
+		return;
+	this->autoscale = false;
+	this->lo = min;
+	this->hi = max;
+	this->step = nice_step(max - min, PLOT_TICKS);
+	this->scaled = true;
+}
+
+void Plot::setLabels(bool on)
+{
+	this->labels = on;
+}
+
+void Plot::setSweep(bool on)
+{
+	this->sweep = on;
+	this->pending = PLOT_MAX_WIDTH + 1; // all of it, at the next update()
+}
+
+// the points of column c are n*c/cols to n*(c+1)/cols - 1, one per column
+// if n fits in the width
+void Plot::setData(const float *points, int n)
+{
+	int cols = this->w - PLOT_AXIS_WIDTH;
+	if (n < cols)
+		cols = n;
+
+	this->clear();
+	for (int c = 0; c < cols; c++) {
+		int i1 = (int) ((long) (c + 1) * n / cols);
+		float cmin = 1, cmax = 0; // empty
+		for (int i = (int) ((long) c * n / cols); i < i1; i++) {
+			if (!finite_value(points[i]))
+				continue;
+			if (cmin > cmax)
+				cmin = cmax = points[i];
+			else if (points[i] < cmin)
+				cmin = points[i];
+			else if (points[i] > cmax)
+				cmax = points[i];
+		}
+		this->commit(cmin, cmax);
+	}
+}
+
+void Plot::setSamplesPerColumn(int n)
+{
+	if (n > 0)
+		this->perColumn = n;
+	this->clear();
+}
+
+void Plot::append(float sample)
+{
+	if (finite_value(sample)) {
+		if (this->accMin > this->accMax)
+			this->accMin = this->accMax = sample;
+		else if (sample < this->accMin)
+			this->accMin = sample;
+		else if (sample > this->accMax)
+			this->accMax = sample;
+	}
+	if (++this->accCount == this->perColumn) {
+		this->commit(this->accMin, this->accMax);
+		this->accCount = 0;
+		this->accMin = 1;
+		this->accMax = 0;
+	}
+}
+
+void Plot::clear()
+{
+	this->columns = 0;
+	this->first = 0;
+	this->pending = PLOT_MAX_WIDTH + 1;
+	this->accCount = 0;
+	this->accMin = 1;
+	this->accMax = 0;
+}
+
+// add a column after the newest, the oldest is dropped if the plot is full
+void Plot::commit(float cmin, float cmax)
+{
+	int cols = this->w - PLOT_AXIS_WIDTH;
+	int c = (this->first + this->columns) % cols;
+	this->colMin[c] = cmin;
+	this->colMax[c] = cmax;
+	if (this->columns < cols)
+		this->columns++;
+	else
+		this->first = (this->first + 1) % cols;
+	if (this->pending <= PLOT_MAX_WIDTH)
+		this->pending++;
+}
+
+float Plot::getMin()
+{
+	return this->lo;
+}
+
+float Plot::getMax()
+{
+	return this->hi;
+}
+
+// fit the scale to the data range, with hysteresis
+void Plot::rescale(float dmin, float dmax)
+{
+	bool grow = dmin < this->lo || dmax > this->hi;
+	bool shrink = dmax - dmin < this->shrink * (this->hi - this->lo);
+	if (this->scaled && !grow && !shrink)
+		return;
+
+	if (dmax - dmin <= 0) { // flat, centred in a span of 20%
+		float half = (dmin != 0) ? fabsf(dmin) * 0.1f : 1;
+		dmin -= half;
+		dmax += half;
+	}
+	this->step = nice_step(dmax - dmin, PLOT_TICKS);
+	this->lo = floorf(dmin / this->step) * this->step;
+	this->hi = ceilf(dmax / this->step) * this->step;
+	this->scaled = true;
+}
+
+// row of value v, clamped to the plot area
+int Plot::row(float v)
+{
+	int r = (int) ((v - this->lo) / (this->hi - this->lo) * (this->h - 1)
+			+ 0.5f);
+	if (r < 0)
+		r = 0;
+	if (r > this->h - 1)
+		r = this->h - 1;
+	return this->y + this->h - 1 - r;
+}
+
+void Plot::draw()
+{
+	int cols = this->w - PLOT_AXIS_WIDTH;
+
+	// data range of the columns
+	float dmin = 1, dmax = 0;
+	for (int n = 0; n < this->columns; n++) {
+		int c = (this->first + n) % cols;
+		if (this->colMin[c] > this->colMax[c])
+			continue; // empty
+		if (dmin > dmax) {
+			dmin = this->colMin[c];
+			dmax = this->colMax[c];
+		}
+		if (this->colMin[c] < dmin)
+			dmin = this->colMin[c];
+		if (this->colMax[c] > dmax)
+			dmax = this->colMax[c];
+	}
+	if (this->autoscale && dmin <= dmax)
+		this->rescale(dmin, dmax);
+
+	this->lcd->clearRect(this->x, this->y, this->w, this->h);
+
+	// y-axis and a tick mark every step, counted by k since lo + step may
+	// round back to lo when step is below the resolution of lo (at most a
+	// tick per row)
+	this->lcd->drawVLine(this->x + 2, this->y, this->y + this->h - 1);
+	int k0 = (int) ceilf(this->lo / this->step);
+	int k1 = (int) floorf(this->hi / this->step + 0.01f);
+	for (int k = k0; k <= k1 && k - k0 < this->h; k++)
+		this->lcd->drawHLine(this->x, this->x + 1, this->row(k * this->step));
+
+	// trace
+	for (int n = 0; n < this->columns; n++)
+		this->drawColumn(n);
+	this->pending = 0;
+
+	this->drawLabels();
+}
+
+// only the new columns of a sweeping plot, at the cursor, and the gap ahead
+void Plot::update()
+{
+	int cols = this->w - PLOT_AXIS_WIDTH;
+	int x0 = this->x + PLOT_AXIS_WIDTH;
+
+	if (!this->sweep || !this->scaled
+			|| this->pending > cols - PLOT_SWEEP_GAP) {
+		this->draw(); // scrolls, or too many new columns
+		return;
+	}
+	if (this->pending == 0)
+		return;
+
+	// the scale grows to fit the new columns at once, and may shrink once
+	// the cursor wraps, both redraw the plot
+	int n0 = this->columns - this->pending;
+	for (int n = n0; n < this->columns; n++) {
+		int c = (this->first + n) % cols;
+		if (!this->autoscale)
+			break;
+		if (c == 0 || (this->colMin[c] <= this->colMax[c]
+				&& (this->colMin[c] < this->lo || this->colMax[c] > this->hi))) {
+			this->draw();
+			return;
+		}
+	}
+
+	int left = x0 + cols; // leftmost column drawn
+	int hidden = this->columns - cols + PLOT_SWEEP_GAP; // columns in the gap
+	for (int n = n0; n < this->columns; n++) {
+		int cx = x0 + (this->first + n) % cols;
+		this->lcd->clearRect(cx, this->y, 1, this->h);
+		this->drawColumn(n);
+		if (cx < left)
+			left = cx;
+	}
+	for (int g = 1; g <= PLOT_SWEEP_GAP + 1; g++) {
+		int cx = x0 + (this->first + this->columns - 1 + g) % cols;
+		this->lcd->clearRect(cx, this->y, 1, this->h);
+		if (g > PLOT_SWEEP_GAP && hidden >= 0)
+			this->drawColumn(hidden); // not joined to the gap now
+		if (cx < left)
+			left = cx;
+	}
+	this->pending = 0;
+
+	if (left < this->labelRight)
+		this->drawLabels(); // over the columns just drawn
+}
+
+// column n of the trace (oldest first), spanning its minimum and maximum and
+// joined to the column on its left; scrolling plots draw column n at x0 + n,
+// sweeping plots at its place in the ring (x0 + slot), and the columns in
+// the PLOT_SWEEP_GAP slots ahead of the newest are not drawn
+void Plot::drawColumn(int n)
+{
+	int cols = this->w - PLOT_AXIS_WIDTH;
+	int c = (this->first + n) % cols;
+	int hidden = this->columns - cols + PLOT_SWEEP_GAP; // columns in the gap
+
+	if (this->colMin[c] > this->colMax[c])
+		return; // no data, the trace is broken
+	if (this->sweep && n < hidden)
+		return;
+
+	int top = this->row(this->colMax[c]);
+	int bottom = this->row(this->colMin[c]);
+	int p = (c + cols - 1) % cols; // previous column
+	bool joined = n > 0 && this->colMin[p] <= this->colMax[p];
+	if (this->sweep && (c == 0 || n == hidden))
+		joined = false; // at the wrap, or after the gap
+	if (joined) {
+		int ptop = this->row(this->colMax[p]);
+		int pbottom = this->row(this->colMin[p]);
+		if (top > pbottom)
+			top = pbottom; // below the previous column, reach up to it
+		else if (bottom < ptop)
+			bottom = ptop; // above it, reach down
+	}
+	int cx = this->x + PLOT_AXIS_WIDTH + (this->sweep ? c : n);
+	this->lcd->drawVLine(cx, top, bottom);
+}
+
+// labels of the ends of the scale, right of the axis
+void Plot::drawLabels()
+{
+	int x1 = this->x + PLOT_AXIS_WIDTH + 1;
+
+	this->labelRight = 0;
+	if (!this->labels || this->h < 16)
+		return;
+	int r1 = this->label(this->hi, x1, this->y);
+	int r2 = this->label(this->lo, x1, this->y + this->h - 8);
+	this->labelRight = (r1 > r2) ? r1 : r2;
+}
+
+// value v at x, y over a cleared box (8 rows), so that the trace under it
+// does not make it unreadable; returns the end of the box
+int Plot::label(float v, int x, int y)
+{
+	char text[16];
+	snprintf(text, sizeof(text), "%.3g", v);
+	int w = 6 * strlen(text) + 1;
+	if (x + w > this->x + this->w)
+		w = this->x + this->w - x;
+	this->lcd->clearRect(x - 1, y, w, 8);
+	this->lcd->drawString(text, x, y);
+	return x - 1 + w;
+}
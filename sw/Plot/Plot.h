@@ -0,0 +1,162 @@
+/* Plot.h
+ *
+ * Author: Petros Fountas
+ * Created on Fri 16 Oct 2026
+ *
+ * Plot widget over the N5110 display: a trace of any number of points in a
+ * rectangle of the display, with a y-axis, tick marks and the labels of the
+ * scale. The points are decimated to the minimum and maximum of each column,
+ * so drawing costs O(width) whatever their number, and each column is drawn
+ * as one vertical span (N5110::drawVLine).
+ *
+ * The points are either set at once, e.g. a spectrum of N bins,
+ *
+ *   Plot plot(&lcd);
+ *   ...
+ *   plot.setData(spectrum, N);
+ *   plot.draw();
+ *   lcd.refresh();
+ *
+ * or appended one by one, for a time series: every setSamplesPerColumn()
+ * samples complete a column, which spans their minimum and maximum, and
+ * scrolls the older columns to the left. The display has no hardware
+ * scrolling, so a scroll rewrites the whole plot; a sweeping plot
+ * (setSweep()) keeps the columns in place and moves a cursor instead, and
+ * update() then draws the new column and the gap ahead of the cursor only:
+ *
+ *   plot.setSamplesPerColumn(8);
+ *   plot.setSweep(true);
+ *   plot.draw();
+ *   ...
+ *   plot.append(temperature);
+ *   plot.update();
+ *   lcd.refreshAsync();
+ *
+ * The scale follows the data with hysteresis: it grows at once to fit them,
+ * but it shrinks only once they span less than a fraction of it, and its
+ * ends are multiples of the tick step (1, 2 or 5 x 10^k), so that it does
+ * not change with every frame.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef PLOT_PLOT_H_
+#define PLOT_PLOT_H_
+
+#include "mbed.h"
+#include "N5110.h"
+
+// largest width of a plot (pixels)
+#define PLOT_MAX_WIDTH 84
+
+// columns left of the trace: tick marks (2) and y-axis (1)
+#define PLOT_AXIS_WIDTH 3
+
+// ticks of the scale (at least)
+#define PLOT_TICKS 4
+
+// blank columns ahead of the cursor of a sweeping plot
+#define PLOT_SWEEP_GAP 2
+
+class Plot {
+public:
+	// plot in the rectangle x, y, w, h of the display (pixels)
+	Plot(N5110 *display, int x = 0, int y = 0, int w = 84, int h = 48);
+
+	// automatic scale (default), shrunk when the data span less than
+	// shrink x the scale; below 1/4 the ends that snap to the tick step may
+	// shrink it on every frame
+	void setAutoscale(float shrink = 0.25f);
+
+	// fixed scale, autoscale off
+	void setRange(float min, float max);
+
+	// labels of the ends of the scale (default on)
+	void setLabels(bool on);
+
+	// set n points, decimated to the columns (one column per point if they
+	// fit); non-finite points (e.g. -inf dB) are skipped
+	void setData(const float *points, int n);
+
+	// samples per column of append() (default 1), clears the data
+	void setSamplesPerColumn(int n);
+
+	// append a sample, the plot scrolls by a column every samples per column
+	void append(float sample);
+
+	// sweep instead of scrolling (default off): the columns of append() stay
+	// in place and the newest is drawn at a cursor that moves across the
+	// plot, ahead of a gap of PLOT_SWEEP_GAP columns, so that update() draws
+	// the new columns only
+	void setSweep(bool on);
+
+	// clear the data
+	void clear();
+
+	// draw into the buffer of the display, which the caller refreshes
+	void draw();
+
+	// draw the columns appended since the last draw() or update(), O(1) per
+	// column; it draws all of them as draw() if the plot scrolls, if the
+	// scale grows to fit them, or once per sweep, when the cursor wraps, so
+	// that the scale may shrink
+	void update();
+
+	// scale of the last draw()
+	float getMin();
+
+	float getMax();
+
+private:
+
+	void rescale(float dmin, float dmax);
+
+	int row(float v);
+
+	int label(float v, int x, int y);
+
+	void drawLabels();
+
+	void drawColumn(int n);
+
+	void commit(float cmin, float cmax);
+
+	N5110 *lcd;
+
+	int x, y, w, h; // plot area
+
+	float lo, hi; // scale
+
+	float step; // between ticks
+
+	bool scaled; // lo and hi are set
+
+	bool autoscale;
+
+	float shrink; // fraction of the scale below which it shrinks
+
+	bool labels;
+
+	float colMin[PLOT_MAX_WIDTH]; // columns of the trace, oldest first from
+
+	float colMax[PLOT_MAX_WIDTH]; // first, empty if colMin > colMax
+
+	int columns; // columns with data
+
+	int first; // oldest column (ring of append())
+
+	int perColumn; // samples per column of append()
+
+	bool sweep;
+
+	int pending; // columns since the last draw, > PLOT_MAX_WIDTH if all
+
+	int labelRight; // end of the boxes of the labels (x), 0 if none
+
+	int accCount; // samples of the column being appended
+
+	float accMin, accMax;
+};
+
+#endif /* PLOT_PLOT_H_ */
@@ -0,0 +1,91 @@
+/* Profiler.cpp
+ *
+ * Author: Petros Fountas
+ * Created on Fri 16 Oct 2026
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "Profiler.h"
+
+ProfileTimer *ProfileTimer::timers = NULL;
+
+ProfileTimer::ProfileTimer(const char *name) {
+
+#ifdef TARGET_CORTEX_M
+	// enable the trace unit and the DWT cycle counter
+	if (timers == NULL) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+#endif
+	this->name = name;
+	reset();
+
+	// append to the registered timers, in order of declaration
+	this->next = NULL;
+	ProfileTimer **last = &timers;
+	while (*last != NULL)
+		last = &(*last)->next;
+	*last = this;
+}
+
+// Add a duration, timers may be shared by threads and interrupt handlers
+void ProfileTimer::add(uint32_t ticks) {
+
+#ifdef TARGET_CORTEX_M
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+#endif
+	this->count++;
+	this->total += ticks;
+	if (ticks < this->min)
+		this->min = ticks;
+	if (ticks > this->max)
+		this->max = ticks;
+#ifdef TARGET_CORTEX_M
+	__set_PRIMASK(primask);
+#endif
+}
+
+void ProfileTimer::reset() {
+
+	this->count = 0;
+	this->min = 0xFFFFFFFF;
+	this->max = 0;
+	this->total = 0;
+}
+
+void ProfileTimer::resetAll() {
+
+	for (ProfileTimer *t = timers; t != NULL; t = t->next)
+		t->reset();
+}
+
+void ProfileTimer::dump(Serial *dev) {
+
+	float us = ticksPerUs();
+
+	dev->printf("%-16s %8s %10s %10s %10s (us)\r\n", "profile", "count",
+			"min", "max", "mean");
+	for (ProfileTimer *t = timers; t != NULL; t = t->next) {
+		if (t->count == 0) {
+			dev->printf("%-16s %8d\r\n", t->name, 0);
+			continue;
+		}
+		dev->printf("%-16s %8lu %10.1f %10.1f %10.1f\r\n", t->name,
+				(unsigned long) t->count, t->min / us, t->max / us,
+				(float) t->total / t->count / us);
+	}
+}
+
+uint32_t ProfileTimer::ticksPerUs() {
+
+#ifdef TARGET_CORTEX_M
+	return SystemCoreClock / 1000000;
+#else
+	return 1000;
+#endif
+}
@@ -0,0 +1,91 @@
+/* Profiler.h
+ *
+ * Author: Petros Fountas
+ * Created on Fri 16 Oct 2026
+ *
+ * Scoped timers, which keep the count, minimum, maximum and mean duration of
+ * a section of code. On the Cortex-M3 the durations are counted in CPU
+ * cycles by the DWT cycle counter (core_cm3.h), on the host in ns by
+ * clock_gettime().
+ *
+ *   ProfileTimer dftTimer("computeDFT");
+ *   ...
+ *   {
+ *       ProfileScope scope(&dftTimer);
+ *       computeDFT();
+ *   }
+ *   ...
+ *   ProfileTimer::dump(&serial);
+ *
+ * Timers are declared at file scope, they register themselves before main().
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef PROFILER_PROFILER_H_
+#define PROFILER_PROFILER_H_
+
+#include "mbed.h"
+
+// Profiling clock, CPU cycles on the Cortex-M3, ns on the host (the
+// duration of a scope is the difference of two ticks, modulo 2^32)
+#ifdef TARGET_CORTEX_M
+static inline uint32_t profile_ticks(void) {
+	return DWT->CYCCNT;
+}
+#else
+#include <time.h>
+static inline uint32_t profile_ticks(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t) (ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+#endif
+
+class ProfileTimer {
+public:
+	ProfileTimer(const char *name);
+
+	// add a duration of ticks
+	void add(uint32_t ticks);
+
+	// clear the statistics
+	void reset();
+
+	// clear the statistics of all timers
+	static void resetAll();
+
+	// print the statistics of all timers (us)
+	static void dump(Serial *dev);
+
+	// ticks of the profiling clock per us
+	static uint32_t ticksPerUs();
+
+private:
+	const char *name;
+	uint32_t count;
+	uint32_t min; // ticks
+	uint32_t max; // ticks
+	uint64_t total; // ticks
+	ProfileTimer *next; // registered timers
+
+	static ProfileTimer *timers;
+};
+
+// Times its scope, from construction to destruction
+class ProfileScope {
+public:
+	ProfileScope(ProfileTimer *timer) : timer(timer), start(profile_ticks()) {
+	}
+
+	~ProfileScope() {
+		timer->add(profile_ticks() - start);
+	}
+
+private:
+	ProfileTimer *timer;
+	uint32_t start;
+};
+
+#endif // PROFILER_PROFILER_H_
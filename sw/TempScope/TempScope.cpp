@@ -13,30 +13,28 @@ using namespace std;
 
 TempScope::TempScope(TMP102 *device)
 {
+	this->daqfreq = 1; // Hz
+	this->nsamples = 64; // samples
+	this->blockSamples = 0;
+	this->currentSample = 0;
+	this->overruns = 0;
+	this->sliding = false;
+	this->windowType = WINDOW_HANN;
 	this->sensor = device;
-	this->signal =
-			new std::vector<float>(this->nsamples);
-	this->signalDFT =
-			new std::vector<complex_t>(this->nsamples);
-	this->signalSpectrum =
-			new std::vector<float>(this->nsamples);
-	this->signalPSD =
-			new std::vector<float>(this->nsamples);
-	this->dftComputeThread =
-			new Thread(this->dft);
-	this->dftUpdateMutex =
+	arena_init(&this->arena, this->arenaMemory, sizeof(this->arenaMemory));
+	this->resizeMutex =
 			new Mutex();
+	this->resize();
+	this->dftComputeThread =
+			new Thread(&TempScope::dftThread, this);
 }
 
 TempScope::~TempScope()
 {
-	delete this->sensor;
-	delete this->signal;
-	delete this->signalDFT;
-	delete this->signalSpectrum;
-	delete this->signalPSD;
+	this->disable();
 	delete this->dftComputeThread;
-	delete this->dftUpdateMutex;
+	delete this->sensor;
+	delete this->resizeMutex;
 }
 
 void TempScope::setAqcuisitionFrequencyInHz(int f)
@@ -45,119 +43,252 @@ void TempScope::setAqcuisitionFrequencyInHz(int f)
 		this->daqfreq = f;
 }
 
+// applied by enable()
 void TempScope::setNumberOfSamples(int n)
 {
-	if (floor(n) > 0)
-		this->nsamples = floor(n);
+	if (is_pow2(n) && n >= 4 && n <= TEMPSCOPE_MAX_SAMPLES)
+		this->nsamples = n;
 }
 
-void enable()
+// must be called while the acquisition is disabled
+void TempScope::setSlidingDFT(bool enable)
 {
-	daqtimer.attach(&this->daq, 1/this->daqfreq);
+	this->sliding = enable;
 }
 
-void disable()
+void TempScope::setWindow(int type)
 {
-	daqtimer.detach();
+	if (type >= WINDOW_RECTANGULAR && type <= WINDOW_KAISER)
+		this->windowType = type;
 }
 
-void TempScope::getSignal(const vector<float>& _retvalue)
+bool TempScope::enable()
 {
-	int N = this->nsamples;
-	this->dftUpdateMutex->lock();
-	_retvalue.vector<float>(this->signal,
-			N+sizeof(this->signal)/sizeof(float));
-	this->dftUpdateMutex->unlock();
+	if (!this->resize()) {
+		this->disable();
+		return false;
+	}
+	this->daqtimer.attach(this, &TempScope::daq, 1.0 / this->daqfreq);
+	return true;
 }
 
-void TempScope::getSignalDFT(const vector<complex_t>& _retvalue)
+void TempScope::disable()
 {
-	int N = this->nsamples;
-	this->dftUpdateMutex->lock();
-	_retvalue.vector<complex_t>(this->signalDFT,
-			N+sizeof(this->signalDFT)/sizeof(complex_t));
-	this->dftUpdateMutex->unlock();
+	this->daqtimer.detach();
 }
 
-void TempScope::getSignalSpectrum(const vector<float>& _retvalue)
+// copy a field of the latest results, retried if the DFT thread publishes
+// during the copy (the DFT thread never waits for the readers)
+template <typename T>
+uint32_t TempScope::read(T *TempScopeResult::*field, int size,
+		vector<T>& _retvalue)
 {
-	int N = this->nsamples;
-	this->dftUpdateMutex->lock();
-	_retvalue.vector<float>(this->signalSpectrum,
-			N+sizeof(this->signalSpectrum)/sizeof(float));
-	this->dftUpdateMutex->unlock();
+	uint32_t seq;
+	do {
+		seq = this->results.sequence();
+		const T *a = this->results.front(seq).*field;
+		_retvalue.assign(a, a + size);
+	} while (!this->results.valid(seq));
+	return seq;
 }
 
-void TempScope::getSignalPSD(const vector<float>& _retvalue)
+uint32_t TempScope::getSignal(vector<float>& _retvalue)
 {
-	int N = this->nsamples;
-	this->dftUpdateMutex->lock();
-	_retvalue.vector<float>(this->signalPSD,
-			N+sizeof(this->signalPSD)/sizeof(float));
-	this->dftUpdateMutex->unlock();
+	return this->read(&TempScopeResult::signal, this->blockSamples,
+			_retvalue);
 }
 
-void TempScope::dftThreadOperation(void const *args)
+uint32_t TempScope::getSignalDFT(vector<complex_t>& _retvalue)
 {
-	while (true) {
+	return this->read(&TempScopeResult::dft, this->blockSamples / 2 + 1,
+			_retvalue);
+}
 
-		Thread::signal_wait(COMPUTE_DFT_SIG); // wait to be signaled
+uint32_t TempScope::getSignalSpectrum(vector<float>& _retvalue)
+{
+	return this->read(&TempScopeResult::spectrum, this->blockSamples,
+			_retvalue);
+}
 
-		int N = this->nsamples;
+uint32_t TempScope::getSignalPSD(vector<float>& _retvalue)
+{
+	return this->read(&TempScopeResult::psd, this->blockSamples,
+			_retvalue);
+}
 
-		// convert signal to complex
-		for (int n = 0; n < N; n++) cx[n] = complex_num(x[n], 0);
+uint32_t TempScope::getSequence()
+{
+	return this->results.sequence();
+}
 
-		// init DFT output sequence
-		complex_t *X = malloc(N*sizeof(complet_x));
-		for (int n = 0; n < N; n++) X[n] = complex_num(0, 0); // init to 0
+template <typename T>
+TempScopeView<T> TempScope::view(T *TempScopeResult::*field, int size)
+{
+	TempScopeView<T> v;
+	v.sequence = this->results.sequence();
+	v.data = this->results.front(v.sequence).*field;
+	v.size = size;
+	return v;
+}
 
-		// compute DFT
-		dft(X, cx, N);
+TempScopeView<float> TempScope::viewSignal()
+{
+	return this->view(&TempScopeResult::signal, this->blockSamples);
+}
 
-		// remove DC component and AC alliases, and spread the rest of the signal
-		complex_t *spectrum = malloc(N*sizeof(complet_x));
-		for (int n = 0; n < N; n++)
-			spectrum[n] = 0;
-		for (int n = 0; n < floor(N / 2) - 1; n++) {
-			spectrum[2 * n] = complex_norm(X[n + 1]);
-			spectrum[2 * n + 1] =
-					(complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
-		}
+TempScopeView<complex_t> TempScope::viewSignalDFT()
+{
+	return this->view(&TempScopeResult::dft, this->blockSamples / 2 + 1);
+}
+
+TempScopeView<float> TempScope::viewSignalSpectrum()
+{
+	return this->view(&TempScopeResult::spectrum, this->blockSamples);
+}
+
+TempScopeView<float> TempScope::viewSignalPSD()
+{
+	return this->view(&TempScopeResult::psd, this->blockSamples);
+}
 
-		// estimate Power Spectral Density (PSD)
-		complex_t *Pxx = malloc(N*sizeof(complet_x));
-		for (int n = 0; n < N; n++) Pxx[n] = 0; // init to 0
-		for (int n = 0; n < floor(N / 2) - 1; n++) {
-			Pxx[2 * n] = 20 * log10(pow(complex_norm(X[n + 1]), 2));
-			float avg = (complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
-			Pxx[2 * n + 1] = 20 * log10(pow(avg, 2));
+bool TempScope::isCurrent(uint32_t sequence)
+{
+	return this->results.valid(sequence);
+}
+
+unsigned TempScope::getOverruns()
+{
+	return this->overruns;
+}
+
+// carve the buffers for nsamples out of the arena and restart the
+// acquisition bucket, while there are no readers, returns false if the
+// arena is too small (no samples until the next successful resize())
+bool TempScope::resize()
+{
+	int N = this->nsamples;
+	size_t block = N * sizeof(float);
+	size_t bins = (N / 2 + 1) * sizeof(complex_t);
+
+	this->resizeMutex->lock();
+	arena_reset(&this->arena);
+	this->signal = (float *) arena_alloc(&this->arena, block);
+	float *w = (float *) arena_alloc(&this->arena, block);
+	float *sdftWindow = (float *) arena_alloc(&this->arena, block);
+	complex_t *sdftBins = (complex_t *) arena_alloc(&this->arena, bins);
+	bool carved = this->signal && w && sdftWindow && sdftBins;
+	for (int i = 0; i < 2; i++) {
+		TempScopeResult &r = this->results.buffers(i);
+		r.signal = (float *) arena_alloc(&this->arena, block);
+		r.dft = (complex_t *) arena_alloc(&this->arena, bins);
+		r.spectrum = (float *) arena_alloc(&this->arena, block);
+		r.psd = (float *) arena_alloc(&this->arena, block);
+		carved = carved && r.signal && r.dft && r.spectrum && r.psd;
+	}
+	if (!carved) {
+		this->blockSamples = 0; // the getters return empty results
+		this->resizeMutex->unlock();
+		return false;
+	}
+	for (int i = 0; i < 2; i++) {
+		TempScopeResult &r = this->results.buffers(i);
+		for (int n = 0; n < N; n++) {
+			r.signal[n] = r.spectrum[n] = r.psd[n] = 0;
+			if (n <= N / 2)
+				r.dft[n] = complex_num(0, 0);
 		}
+	}
+
+	for (int n = 0; n < N; n++)
+		this->signal[n] = 0;
+	window_init(&this->win, w, this->windowType, N, WINDOW_KAISER_BETA);
+	sdft_init(&this->sdft, sdftWindow, sdftBins, N, SDFT_R);
+	this->currentSample = 0;
+	this->blockSamples = N;
+	this->resizeMutex->unlock();
+	return true;
+}
+
+void TempScope::dftThread(void const *args)
+{
+	((TempScope *) args)->dftThreadOperation();
+}
+
+void TempScope::dftThreadOperation()
+{
+	while (true) {
 
+		Thread::signal_wait(COMPUTE_DFT_SIG); // wait to be signaled
 
-		// store X, spectrum, Pxx
-		this->dftUpdateMutex->lock(); // RAW (Read-After-Write)
-		for (int i = 0; i < N; i++) {
-			this->signalDFT->push_back(X[i]);
-			this->signalSpectrum->push_back(spectrum[i]);
-			this->signalPSD->push_back(Pxx[i]);
+		// drain the samples of daq() in place, the DFT of a block is
+		// computed as soon as it completes, before the next block
+		// overwrites it
+		bool update = false;
+		uint32_t n;
+		const float *s;
+		this->resizeMutex->lock();
+		while ((s = this->samples.peek(&n)), n > 0) {
+			for (uint32_t i = 0; i < n && this->blockSamples; i++) {
+				this->signal[this->currentSample] = s[i];
+				this->currentSample =
+						(this->currentSample + 1) % this->blockSamples;
+				if (this->sliding) {
+					sdft_update(&this->sdft, s[i]);
+					update = true;
+				} else if (!this->currentSample)
+					this->computeDFT();
+			}
+			this->samples.consume(n);
 		}
-		this->dftUpdateMutex->unlock();
 
-		free(X); // release DFT output sequence
-		free(spectrum); // release spectrum temp
-		free(Pxx); // release PSD temp
+		// the sliding DFT is already updated by every sample
+		if (update)
+			this->computeDFT();
+		this->resizeMutex->unlock();
 	}
 }
 
+// compute the results into the back buffer of the snapshot and publish them
+// (the readers keep reading the front buffer meanwhile)
+void TempScope::computeDFT()
+{
+	int N = this->blockSamples;
+	TempScopeResult &r = this->results.back();
+	float cg = 1, U = 1; // window gains
+
+	for (int n = 0; n < N; n++)
+		r.signal[n] = this->signal[n];
+	if (this->sliding) {
+		// DFT of the last N samples
+		for (int n = 0; n <= N / 2; n++)
+			r.dft[n] = this->sdft.X[n];
+	} else {
+		// window of the configured type, rebuilt in place if it changed
+		if (this->win.type != this->windowType)
+			window_init(&this->win, this->win.w, this->windowType, N,
+					WINDOW_KAISER_BETA);
+
+		// compute DFT of the last windowed block
+		rfftw(r.dft, this->signal, this->win.w, N);
+		cg = this->win.cg;
+		U = this->win.U;
+	}
+
+	// remove DC component and AC alliases, spread the rest of the signal
+	// and estimate Power Spectral Density (PSD) in one pass
+	spectrum_psd(r.spectrum, r.psd, r.dft, N, 2.0f / (N * cg),
+			2.0f / (this->daqfreq * N * U));
+
+	this->results.publish();
+}
+
+// Ticker ISR, hands the sample to the DFT thread through the ring buffer
+// (no locks, no allocations)
 void TempScope::daq()
 {
 	float temp = 0;
 	sensor->temp(&temp); // get temperature
-	this->signal->push_back(temp);
-	mod(++this->currSample,this->nsamples);
-	if (!this->currSample) {
-		// run DFT computation thread
-		this->dftComputeThread->signal_set(COMPUTE_DFT_SIG);
-	}
+	if (!this->samples.push(temp))
+		this->overruns++; // the DFT thread is behind, drop the sample
+	this->dftComputeThread->signal_set(COMPUTE_DFT_SIG);
 }
@@ -11,6 +11,41 @@
 #include "rtos.h"
 #include "TMP102.h"
 #include "dsp.h"
+#include <vector>
+
+// samples buffered between the acquisition ISR and the DFT thread
+#define TEMPSCOPE_RING_SIZE 64
+
+// largest number of samples, which sizes the arena of the buffers
+#ifndef TEMPSCOPE_MAX_SAMPLES
+#define TEMPSCOPE_MAX_SAMPLES 128
+#endif
+
+// arena of N samples: the block, the window and the sliding DFT window
+// (3 x N floats), the sliding DFT bins (N/2+1 bins) and two result sets
+// (2 x 3 x N floats, 2 x N/2+1 bins), and the bytes arena_init() may skip
+// to align the start of the memory, which is only byte aligned
+#define TEMPSCOPE_ARENA_SIZE(N) \
+		(9 * ARENA_SIZE((N) * sizeof(float)) + \
+		 3 * ARENA_SIZE(((N) / 2 + 1) * sizeof(complex_t)) + \
+		 ARENA_ALIGN - 1)
+
+// results of a DFT, published together by the DFT thread
+struct TempScopeResult {
+	float *signal; // block of N samples (circular if sliding)
+	complex_t *dft; // N/2+1 bins
+	float *spectrum; // N
+	float *psd; // N
+};
+
+// read-only view of a result array, valid while the results of its sequence
+// number are the latest (see TempScope::isCurrent)
+template <typename T>
+struct TempScopeView {
+	const T *data;
+	int size;
+	uint32_t sequence; // of the results
+};
 
 class TempScope {
 public:
@@ -19,45 +54,108 @@ public:
 
 	void setAqcuisitionFrequencyInHz(int f);
 
+	// power of two up to TEMPSCOPE_MAX_SAMPLES, applied by enable()
 	void setNumberOfSamples(int n);
 
-	void enable();
+	// sliding DFT mode, the spectrum is updated on every sample instead of
+	// every block of samples
+	void setSlidingDFT(bool enable);
+
+	// window applied to the blocks of samples (WINDOW_* of window.h), the
+	// sliding DFT is not windowed
+	void setWindow(int type);
+
+	// carve the buffers for the configuration out of the arena, and start
+	// the acquisition (nothing is allocated afterwards), returns false and
+	// leaves the acquisition stopped if the arena is too small
+	bool enable();
 
 	void disable();
 
-	void getSignal(const std::vector<float>& _retvalue);
+	// the getters copy the latest results without blocking the DFT thread,
+	// and return their sequence number (0 until the first DFT)
+	uint32_t getSignal(std::vector<float>& _retvalue);
+
+	uint32_t getSignalDFT(std::vector<complex_t>& _retvalue);
+
+	uint32_t getSignalSpectrum(std::vector<float>& _retvalue);
+
+	uint32_t getSignalPSD(std::vector<float>& _retvalue);
+
+	// sequence number of the latest results
+	uint32_t getSequence();
+
+	// views into the latest results, without copies: the DFT thread may
+	// overwrite them once it publishes new results, so a reader renders from
+	// a view and then checks isCurrent(view.sequence), and takes new views
+	// and renders again if it is not
+	TempScopeView<float> viewSignal();
+
+	TempScopeView<complex_t> viewSignalDFT();
+
+	TempScopeView<float> viewSignalSpectrum();
 
-	void getSignalDFT(const std::vector<complex_t>& _retvalue);
+	TempScopeView<float> viewSignalPSD();
 
-	void getSignalSpectrum(const std::vector<float>& _retvalue);
+	// true if no results were published after sequence, i.e. its views were
+	// not overwritten
+	bool isCurrent(uint32_t sequence);
 
-	void getSignalPSD(const std::vector<float>& _retvalue);
+	// samples dropped because the DFT thread fell behind
+	unsigned getOverruns();
 
 private:
 
-	void dftThreadOperation(void const *args);
+	static void dftThread(void const *args);
+
+	void dftThreadOperation();
+
+	void computeDFT();
 
 	void daq();
 
-	int daqfreq = 1; // Hz
+	bool resize();
+
+	template <typename T>
+	uint32_t read(T *TempScopeResult::*field, int size,
+			std::vector<T>& _retvalue);
+
+	template <typename T>
+	TempScopeView<T> view(T *TempScopeResult::*field, int size);
+
+	int daqfreq; // Hz
+
+	int nsamples; // samples, configured
 
-	int nsamples = 64; // samples
+	int blockSamples; // samples of the buffers
 
-	int currentSample = 0; // in DFT bucket
+	int currentSample; // in DFT bucket
+
+	dsp::ring_buffer<float, TEMPSCOPE_RING_SIZE> samples; // daq() to thread
+
+	volatile unsigned overruns; // samples dropped by daq()
+
+	bool sliding; // sliding DFT mode
+
+	int windowType; // WINDOW_*
 
 	TMP102 *sensor;
 
 	Ticker daqtimer;
 
-	std::vector<float> *signal;
+	float *signal; // block being acquired
+
+	window_t win; // window of the blocks
+
+	dsp::snapshot<TempScopeResult> results;
 
-	std::vector<complex_t> *signalDFT;
+	sdft_t sdft;
 
-	std::vector<float> *signalSpectrum;
+	arena_t arena;
 
-	std::vector<float> *signalPSD;
+	unsigned char arenaMemory[TEMPSCOPE_ARENA_SIZE(TEMPSCOPE_MAX_SAMPLES)];
 
-	Mutex *dftUpdateMutex;
+	Mutex *resizeMutex; // buffers of the DFT thread against resize()
 
 	Thread *dftComputeThread;
 
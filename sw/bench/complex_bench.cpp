@@ -0,0 +1,125 @@
+/* complex_bench.cpp
+ *
+ * Host benchmark of the per-call overhead of the complex operations, which
+ * compares the former out-of-line C implementation (reproduced below, not
+ * inlined) with the inline operations of complex_numbers.h.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target complex_bench && build/complex_bench
+ */
+#include "mbed.h"
+#include "complex_numbers.h"
+#include <time.h>
+
+#define REPEAT_NS 200000000L // run every case for about 0.2 s
+#define LEN 1024             // elements per call
+
+#define NOINLINE __attribute__((noinline))
+
+// Former out-of-line operations
+NOINLINE complex_t old_complex_add(complex_t a, complex_t b) {
+
+	complex_t c;
+	c.real = a.real + b.real;
+	c.imag = a.imag + b.imag;
+	return c;
+}
+
+NOINLINE complex_t old_complex_mul(complex_t a, complex_t b) {
+
+	complex_t c;
+	c.real = a.real * b.real - a.imag * b.imag;
+	c.imag = a.real * b.imag + a.imag * b.real;
+	return c;
+}
+
+NOINLINE float old_complex_norm(complex_t c) {
+
+	float z = sqrt(pow(c.real, 2) + pow(c.imag, 2));
+	return z;
+}
+
+static complex_t x[LEN], w[LEN];
+static float m[LEN];
+static volatile float sink;
+
+// Multiply-accumulate, y = ∑ x[n]･w[n]
+static void mac_old() {
+
+	complex_t y = {0, 0};
+	for (int n = 0; n < LEN; n++)
+		y = old_complex_add(y, old_complex_mul(x[n], w[n]));
+	sink = y.real + y.imag;
+}
+
+static void mac_new() {
+
+	complex_t y = {0, 0};
+	for (int n = 0; n < LEN; n++)
+		y = complex_add(y, complex_mul(x[n], w[n]));
+	sink = y.real + y.imag;
+}
+
+// Norms, m[n] = |x[n]|
+static void norm_old() {
+
+	for (int n = 0; n < LEN; n++)
+		m[n] = old_complex_norm(x[n]);
+	sink = m[LEN - 1];
+}
+
+static void norm_new() {
+
+	for (int n = 0; n < LEN; n++)
+		m[n] = complex_norm(x[n]);
+	sink = m[LEN - 1];
+}
+
+static double now_ns() {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Time one case, returns ns per element
+static double run(void (*f)()) {
+
+	long calls = 0, batch = 1;
+	double t0 = now_ns(), t = t0;
+	while (t - t0 < REPEAT_NS) {
+		for (long i = 0; i < batch; i++)
+			f();
+		calls += batch;
+		batch *= 2;
+		t = now_ns();
+	}
+
+	return (t - t0) / calls / LEN;
+}
+
+int main() {
+
+	srand(1);
+	for (int n = 0; n < LEN; n++) {
+		x[n] = complex_num(rand() / (float) RAND_MAX - 0.5f,
+				rand() / (float) RAND_MAX - 0.5f);
+		w[n] = complex_num(rand() / (float) RAND_MAX - 0.5f,
+				rand() / (float) RAND_MAX - 0.5f);
+	}
+
+	printf("%-6s %14s %14s %8s\n", "op", "out-of-line", "inline", "speedup");
+
+	double t_old = run(mac_old), t_new = run(mac_new);
+	printf("%-6s %11.2f ns %11.2f ns %7.2fx\n",
+			"mac", t_old, t_new, t_old / t_new);
+
+	t_old = run(norm_old);
+	t_new = run(norm_new);
+	printf("%-6s %11.2f ns %11.2f ns %7.2fx\n",
+			"norm", t_old, t_new, t_old / t_new);
+
+	return 0;
+}
@@ -0,0 +1,562 @@
+/* dsp_bench.cpp
+ *
+ * Host benchmark suite of the dsp/ kernels, which sweeps the transform size
+ * N and reports, for every kernel, the time per operation, the throughput
+ * in samples per second, the heap allocations per operation (malloc,
+ * calloc and realloc are wrapped at link time, see CMakeLists.txt) and the
+ * trigonometric calls per operation (sinf, cosf and sincosf, wrapped the
+ * same way). The kernels that keep tables (twiddle, window, fft_soa) are
+ * called once before they are timed, so the allocations are those of the
+ * steady state.
+ *
+ * dft_trig and twiddle_trig are the baseline of the twiddle tables: the
+ * direct DFT as it evaluated complex_exp() for every term, and the
+ * factors evaluated with complex_exp(), against dft and twiddle.
+ *
+ * An operation processes a block of N samples, e.g. N calls of
+ * sdft_update(), so that the throughput of the kernels can be compared.
+ * computeDFT and computePSD are the float pipelines of main.cpp, and
+ * computeDFT_q15 is the Q15 pipeline (which also derives the PSD), to
+ * compare the two; on the target, the "computeDFT" profile timer of main.cpp
+ * counts their cycles (see Profiler.h) in a build with and without
+ * FIXED_POINT=1.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target dsp_bench && build/dsp_bench
+ *
+ * Usage:
+ *
+ *   dsp_bench [--json FILE] [--filter NAME] [--n N,N,...] [--time S]
+ *   dsp_bench --compare BASE.json NEW.json [--threshold PCT]
+ *
+ * --json writes the results as JSON, one result object per line. --compare
+ * reads two such files and flags every kernel that is more than PCT percent
+ * (default 10) slower, or allocates more, in NEW than in BASE. It exits
+ * with status 1 if there is any regression, so that it can gate a change.
+ */
+#include "mbed.h"
+#include "dsp.h"
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define NMAX 4096       // largest N of the sweep
+#define NAME_LEN 32     // maximum kernel name length
+#define MAX_RESULTS 256 // maximum results of a file in --compare
+
+// Heap allocations, counted by the wrappers of malloc, calloc and realloc
+static volatile long allocs = 0;
+
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t n, size_t size);
+extern "C" void *__real_realloc(void *p, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size) {
+
+	allocs++;
+	return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size) {
+
+	allocs++;
+	return __real_calloc(n, size);
+}
+
+extern "C" void *__wrap_realloc(void *p, size_t size) {
+
+	allocs++;
+	return __real_realloc(p, size);
+}
+
+// Trigonometric calls, counted by the wrappers of sinf, cosf and sincosf
+// (the compiler merges the sinf and cosf of complex_exp() into sincosf)
+static volatile long trigs = 0;
+
+extern "C" float __real_sinf(float a);
+extern "C" float __real_cosf(float a);
+extern "C" void __real_sincosf(float a, float *s, float *c);
+
+extern "C" float __wrap_sinf(float a) {
+
+	trigs++;
+	return __real_sinf(a);
+}
+
+extern "C" float __wrap_cosf(float a) {
+
+	trigs++;
+	return __real_cosf(a);
+}
+
+extern "C" void __wrap_sincosf(float a, float *s, float *c) {
+
+	trigs++;
+	__real_sincosf(a, s, c);
+}
+
+// Input and output buffers of the kernels, sized for NMAX
+static float x[NMAX];           // real signal
+static float y[NMAX];           // real output
+static float w[NMAX];           // Hann window
+static complex_t xc[NMAX];      // complex signal
+static complex_t X[NMAX];       // DFT
+static complex_q15_t q[NMAX];   // Q15 DFT
+static float spectrum[NMAX];
+static float Pxx[NMAX];
+static float P[NMAX / 2 + 1];
+static complex_soa_t soa;
+
+static window_t win;
+static sdft_t sdft;
+static float sdft_x[NMAX];
+static complex_t sdft_X[NMAX / 2 + 1];
+static goertzel_bank_t bank;
+static goertzel_t filters[4];
+static welch_t welch;
+static float welch_work[WELCH_WORK_SIZE(NMAX)];
+
+static Serial serial(USBTX, USBRX); // chplot output, sent to /dev/null
+
+static volatile float sink; // keeps the results of the scalar kernels
+
+#define Fs 1000 // Hz
+
+
+// --- Kernels, one operation processes N samples, 0 on success ---
+
+static int op_complex_norm(int N) {
+
+	float acc = 0;
+	for (int k = 0; k < N; k++)
+		acc += complex_norm(X[k]);
+	sink = acc;
+	return 0;
+}
+
+static int op_twiddle(int N) {
+
+	float acc = 0;
+	for (int k = 0; k < N; k++)
+		acc += twiddle(N, k).real;
+	sink = acc;
+	return 0;
+}
+
+// baseline of op_twiddle, W(N)^k evaluated with complex_exp()
+static int op_twiddle_trig(int N) {
+
+	float acc = 0;
+	for (int k = 0; k < N; k++)
+		acc += complex_exp(complex_num(0, -2 * M_PI * k / N)).real;
+	sink = acc;
+	return 0;
+}
+
+static int op_window_init(int N) {
+
+	return window_init(&win, y, WINDOW_HANN, N, 0);
+}
+
+static int op_sin_wave(int N) {
+
+	float A[3] = { 1, 0.5f, 0.25f };
+	float f[3] = { 50, 125, 300 };
+	float p[3] = { 0, 0.5f, 1 };
+	sin_wave(y, N, Fs, A, f, p, 3);
+	return 0;
+}
+
+// dft() adds into its output, which prepare_dft() zeroes before each call
+static int op_dft(int N) {
+
+	dft(X, xc, N);
+	return 0;
+}
+
+static void prepare_dft(int N) {
+
+	memset(X, 0, N * sizeof(complex_t));
+}
+
+// baseline of op_dft, the direct DFT before the twiddle tables
+static int op_dft_trig(int N) {
+
+	for (int k = 0; k < N; k++) {
+		complex_t acc = complex_num(0, 0);
+		for (int n = 0; n < N; n++)
+			acc += xc[n] * complex_exp(complex_num(0, -2 * M_PI * k * n / N));
+		X[k] = acc;
+	}
+	return 0;
+}
+
+static int op_fft(int N) {
+
+	return fft(X, xc, N);
+}
+
+static int op_rfft(int N) {
+
+	return rfft(X, x, N);
+}
+
+static int op_rfftw(int N) {
+
+	return rfftw(X, x, w, N);
+}
+
+// including the conversion of the input
+static int op_fft_soa(int N) {
+
+	complex_soa_from(&soa, xc, N);
+	return fft_soa(&soa, N);
+}
+
+// including the conversion of the input
+static int op_fft_q15(int N) {
+
+	int e = q15_from_float(q, x, w, N, 1);
+	return fft_q15(q, N, &e);
+}
+
+static int op_sdft_update(int N) {
+
+	for (int n = 0; n < N; n++)
+		sdft_update(&sdft, x[n]);
+	return 0;
+}
+
+static int op_goertzel_update(int N) {
+
+	for (int n = 0; n < N; n++)
+		goertzel_update(&bank, x[n]);
+	return 0;
+}
+
+static int op_welch_push(int N) {
+
+	for (int n = 0; n < N; n++)
+		welch_push(&welch, x[n]);
+	return 0;
+}
+
+static int op_spectrum_psd(int N) {
+
+	spectrum_psd(spectrum, Pxx, X, N, 2.0f / N, 2.0f / (Fs * N));
+	return 0;
+}
+
+// computeDFT() of main.cpp
+static int op_computeDFT(int N) {
+
+	return pipeline_dft(spectrum, X, x, &win, N);
+}
+
+// computeDFT() of main.cpp in the Q15 pipeline (DSP_FIXED_POINT), which
+// also derives the PSD of the block
+static int op_computeDFT_q15(int N) {
+
+	int e;
+	return pipeline_dft_q15(spectrum, Pxx, q, &e, x, &win, N, Fs);
+}
+
+// computePSD() of main.cpp
+static int op_computePSD(int N) {
+
+	pipeline_psd(Pxx, P, &welch, &win, N, Fs);
+	return 0;
+}
+
+static int op_chplot(int N) {
+
+	chplot(x, N, 48, '*', &serial);
+	return 0;
+}
+
+
+// Kernel of the suite, prepare (if not NULL) is called before every
+// operation, outside the timed region
+typedef struct {
+	const char *name;
+	int (*op)(int N);
+	void (*prepare)(int N);
+} kernel_t;
+
+static const kernel_t kernels[] = {
+	{ "complex_norm", op_complex_norm },
+	{ "twiddle", op_twiddle },
+	{ "twiddle_trig", op_twiddle_trig },
+	{ "window_init", op_window_init },
+	{ "sin_wave", op_sin_wave },
+	{ "dft", op_dft, prepare_dft },
+	{ "dft_trig", op_dft_trig },
+	{ "fft", op_fft },
+	{ "rfft", op_rfft },
+	{ "rfftw", op_rfftw },
+	{ "fft_soa", op_fft_soa },
+	{ "fft_q15", op_fft_q15 },
+	{ "sdft_update", op_sdft_update },
+	{ "goertzel_update", op_goertzel_update },
+	{ "welch_push", op_welch_push },
+	{ "spectrum_psd", op_spectrum_psd },
+	{ "computeDFT", op_computeDFT },
+	{ "computeDFT_q15", op_computeDFT_q15 },
+	{ "computePSD", op_computePSD },
+	{ "chplot", op_chplot },
+};
+
+#define KERNELS ((int) (sizeof(kernels) / sizeof(kernels[0])))
+
+
+// Result of a kernel at a size N
+typedef struct {
+	char name[NAME_LEN];
+	int N;
+	double ns;     // per operation
+	double sps;    // samples per second
+	double allocs; // per operation
+	double trigs;  // per operation
+} result_t;
+
+
+static double now_ns() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+// Signal, window and kernel states for the size N
+static int setup(int N) {
+
+	srand(N);
+	for (int n = 0; n < N; n++) {
+		x[n] = 25 + 2 * sinf(2 * M_PI * 50 * n / Fs) +
+				(rand() / (float) RAND_MAX - 0.5f) * 0.1f;
+		xc[n] = complex_num(x[n], 0);
+	}
+	rfft(X, x, N);
+	window_init(&win, w, WINDOW_HANN, N, 0);
+	sdft_init(&sdft, sdft_x, sdft_X, N, SDFT_R);
+	goertzel_init(&bank, filters, 4, N, Fs);
+	for (int i = 0; i < 4; i++)
+		goertzel_add(&bank, 50 * (i + 1));
+	welch_init(&welch, welch_work, N, WELCH_OVERLAP_50(N), w, 16);
+	for (int n = 0; n < N; n++)
+		welch_push(&welch, x[n]);
+	complex_soa_free(&soa);
+	return complex_soa_alloc(&soa, N);
+}
+
+
+// Time op(N) for about t seconds, in batches that double in size, less the
+// time of prepare()
+static int measure(const kernel_t *k, int N, double t, result_t *r) {
+
+	int out = dup(STDOUT_FILENO), null = -1;
+	if (k->op == op_chplot) {
+		fflush(stdout);
+		null = open("/dev/null", O_WRONLY);
+		dup2(null, STDOUT_FILENO);
+	}
+
+	if (k->prepare != NULL)
+		k->prepare(N);
+	int status = k->op(N); // warm up (tables, caches)
+	long calls = 0, batch = 1, a0 = allocs, c0 = trigs;
+	double t0 = now_ns(), t1 = t0, paused = 0;
+	while (status == 0 && t1 - t0 < t * 1e9) {
+		for (long i = 0; i < batch; i++) {
+			if (k->prepare != NULL) {
+				double p0 = now_ns();
+				k->prepare(N);
+				paused += now_ns() - p0;
+			}
+			k->op(N);
+		}
+		calls += batch;
+		batch *= 2;
+		t1 = now_ns();
+	}
+	long a1 = allocs, c1 = trigs;
+
+	if (null >= 0) {
+		fflush(stdout);
+		dup2(out, STDOUT_FILENO);
+		close(null);
+	}
+	close(out);
+
+	if (status != 0)
+		return -1;
+	strncpy(r->name, k->name, NAME_LEN - 1);
+	r->name[NAME_LEN - 1] = 0;
+	r->N = N;
+	r->ns = (t1 - t0 - paused) / calls;
+	r->sps = N / (r->ns * 1e-9);
+	r->allocs = (double) (a1 - a0) / calls;
+	r->trigs = (double) (c1 - c0) / calls;
+	return 0;
+}
+
+
+static void write_json(FILE *fp, const result_t *r, int n) {
+
+	fprintf(fp, "{\n\"suite\": \"dsp_bench\",\n\"results\": [\n");
+	for (int i = 0; i < n; i++)
+		fprintf(fp, "{\"name\": \"%s\", \"N\": %d, \"ns_per_op\": %.1f, "
+				"\"samples_per_s\": %.0f, \"allocs_per_op\": %.3f, "
+				"\"trig_per_op\": %.0f}%s\n",
+				r[i].name, r[i].N, r[i].ns, r[i].sps, r[i].allocs,
+				r[i].trigs, (i < n - 1) ? "," : "");
+	fprintf(fp, "]\n}\n");
+}
+
+
+// Read the results of a file written by write_json(), returns their number
+// or -1 if the file cannot be read
+static int read_json(const char *path, result_t *r, int max) {
+
+	FILE *fp = fopen(path, "r");
+	if (fp == NULL)
+		return -1;
+
+	char line[256];
+	int n = 0;
+	while (n < max && fgets(line, sizeof(line), fp) != NULL) {
+		if (sscanf(line, " {\"name\": \"%31[^\"]\", \"N\": %d, \"ns_per_op\": "
+				"%lf, \"samples_per_s\": %lf, \"allocs_per_op\": %lf",
+				r[n].name, &r[n].N, &r[n].ns, &r[n].sps, &r[n].allocs) == 5)
+			n++;
+	}
+	fclose(fp);
+	return n;
+}
+
+
+// Compare NEW with BASE, returns the number of regressions
+static int compare(const char *base_path, const char *new_path, double pct) {
+
+	static result_t base[MAX_RESULTS], next[MAX_RESULTS];
+	int nb = read_json(base_path, base, MAX_RESULTS);
+	int nn = read_json(new_path, next, MAX_RESULTS);
+	if (nb < 0 || nn < 0) {
+		fprintf(stderr, "cannot read %s\n", (nb < 0) ? base_path : new_path);
+		return -1;
+	}
+
+	int regressions = 0;
+	printf("%-16s %6s %12s %12s %8s  %s\n", "kernel", "N", "base(ns)",
+			"new(ns)", "change", "");
+	for (int i = 0; i < nn; i++) {
+		const result_t *b = NULL;
+		for (int j = 0; j < nb && b == NULL; j++)
+			if (!strcmp(base[j].name, next[i].name) && base[j].N == next[i].N)
+				b = &base[j];
+		if (b == NULL) {
+			printf("%-16s %6d %12s %12.1f %8s  new\n", next[i].name,
+					next[i].N, "-", next[i].ns, "");
+			continue;
+		}
+
+		double change = (next[i].ns - b->ns) / b->ns * 100;
+		const char *flag = "";
+		if (change > pct)
+			flag = "REGRESSION";
+		else if (next[i].allocs > b->allocs)
+			flag = "REGRESSION (allocations)";
+		else if (change < -pct)
+			flag = "improved";
+		if (flag[0] == 'R')
+			regressions++;
+		printf("%-16s %6d %12.1f %12.1f %+7.1f%%  %s\n", next[i].name,
+				next[i].N, b->ns, next[i].ns, change, flag);
+	}
+
+	printf("%d regression(s) above %.1f%%\n", regressions, pct);
+	return regressions;
+}
+
+
+int main(int argc, char **argv) {
+
+	const char *json = NULL, *filter = NULL, *sizes = "16,64,256,1024,4096";
+	const char *base = NULL, *next = NULL;
+	double t = 0.1, pct = 10;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--json") && i + 1 < argc)
+			json = argv[++i];
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			filter = argv[++i];
+		else if (!strcmp(argv[i], "--n") && i + 1 < argc)
+			sizes = argv[++i];
+		else if (!strcmp(argv[i], "--time") && i + 1 < argc)
+			t = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--threshold") && i + 1 < argc)
+			pct = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--compare") && i + 2 < argc) {
+			base = argv[++i];
+			next = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [--json FILE] [--filter NAME] "
+					"[--n N,N,...] [--time S]\n"
+					"       %s --compare BASE.json NEW.json "
+					"[--threshold PCT]\n", argv[0], argv[0]);
+			return 2;
+		}
+	}
+
+	if (base != NULL) {
+		int regressions = compare(base, next, pct);
+		return (regressions < 0) ? 2 : (regressions > 0);
+	}
+
+	static result_t results[MAX_RESULTS];
+	int n = 0;
+
+	printf("%-16s %6s %12s %14s %10s %10s\n", "kernel", "N", "ns/op",
+			"samples/s", "allocs/op", "trig/op");
+	for (const char *s = sizes; *s != 0; s += strcspn(s, ","), s += (*s == ',')) {
+		int N = atoi(s);
+		if (N < 4 || N > NMAX || !is_pow2(N)) {
+			fprintf(stderr, "N = %d is not a power of two in [4, %d]\n", N,
+					NMAX);
+			return 2;
+		}
+		if (setup(N) != 0) {
+			fprintf(stderr, "out of memory\n");
+			return 2;
+		}
+
+		for (int k = 0; k < KERNELS && n < MAX_RESULTS; k++) {
+			if (filter != NULL && strstr(kernels[k].name, filter) == NULL)
+				continue;
+			if (measure(&kernels[k], N, t, &results[n]) != 0) {
+				printf("%-16s %6d %12s\n", kernels[k].name, N, "n/a");
+				continue;
+			}
+			printf("%-16s %6d %12.1f %14.0f %10.3f %10.0f\n", results[n].name,
+					N, results[n].ns, results[n].sps, results[n].allocs,
+					results[n].trigs);
+			n++;
+		}
+	}
+
+	if (json != NULL) {
+		FILE *fp = fopen(json, "w");
+		if (fp == NULL) {
+			fprintf(stderr, "cannot write %s\n", json);
+			return 2;
+		}
+		write_json(fp, results, n);
+		fclose(fp);
+	}
+
+	complex_soa_free(&soa);
+	return 0;
+}
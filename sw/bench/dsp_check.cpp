@@ -0,0 +1,201 @@
+/* dsp_check.cpp
+ *
+ * Host check of the transforms of dsp/ against the direct dft(), for every
+ * power of two N from NMIN to NMAX: fft() of a random complex signal must
+ * match dft() within TOLERANCE, the error being the norm of the difference
+ * relative to the norm of the dft() output,
+ *
+ *      ||fft(x) - dft(x)|| / ||dft(x)|| < TOLERANCE.
+ *
+ * rfft() of a random real signal must match the N/2+1 unique bins of dft()
+ * in the same way, and rfftw() with a Hann window the dft() of the signal
+ * windowed beforehand.
+ *
+ * fft_q15() of a random signal and of a full-scale tone (converted by
+ * q15_from_float()) must keep the SNR of its output against the float fft()
+ * of the same signal above SNR_BOUND(N) dB, the loss of block floating point
+ * growing with the stages of the transform.
+ *
+ * The outputs of a bank of Goertzel filters must match, at their bins, the
+ * spectrum[] and Pxx[] of spectrum_psd() of the rfft() of the same block,
+ * within GOERTZEL_TOLERANCE (relative) and GOERTZEL_DB (dB), i.e. be in the
+ * same units.
+ *
+ * The program prints the error of every size and exits with status 1 if any
+ * check fails.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target dsp_check && build/dsp_check
+ */
+#include "mbed.h"
+#include "dsp.h"
+
+#define NMIN 16
+#define NMAX 4096
+
+// relative error of the float transforms, the roundings of the dft() sums of
+// N terms dominate (about 1e-6 at N = 4096)
+#define TOLERANCE 1e-5
+
+// least SNR of fft_q15() against fft() (dB), 2.5 dB less every stage, as a
+// block that grows by sqrt(2) per stage is shifted by a bit every 2 stages
+// (measured: 69-75 dB at N = 16, 60 and 50 dB at N = 4096)
+#define SNR_BOUND(N) (74 - 2.5 * log2((double) (N)))
+
+// Goertzel bank against the spectrum of the rfft() (Fs in Hz), the float
+// recursion loses precision as N grows (1.4% at bin 1 of N = 4096), so the
+// bounds check the scales of the outputs rather than their accuracy
+#define GOERTZEL_TOLERANCE 0.05
+#define GOERTZEL_DB        0.5
+#define Fs                 1000
+
+static complex_t x[NMAX];
+static float spectrum[NMAX];
+static float Pxx[NMAX];
+static complex_q15_t q[NMAX];
+static float xr[NMAX];   // real signal
+static float w[NMAX];    // window
+static complex_t X[NMAX]; // dft(), reference
+static complex_t Y[NMAX]; // transform under test
+
+static int failures = 0;
+
+// ||Y - X|| / ||X|| over n bins
+static double error(const complex_t *Y, const complex_t *X, int n) {
+
+	double e = 0, s = 0;
+	for (int k = 0; k < n; k++) {
+		double dr = Y[k].real - X[k].real, di = Y[k].imag - X[k].imag;
+		e += dr * dr + di * di;
+		s += (double) X[k].real * X[k].real + (double) X[k].imag * X[k].imag;
+	}
+	return sqrt(e / s);
+}
+
+static void check(const char *name, int N, double e, double tolerance) {
+
+	bool ok = e < tolerance;
+	printf("%-10s %6d %12.3g %s\n", name, N, e, ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+}
+
+// SNR (dB) of q･2^e against the float transform X
+static double snr(const complex_q15_t *q, int e, const complex_t *X, int n) {
+
+	double s = 0, d = 0;
+	for (int k = 0; k < n; k++) {
+		double qr = ldexp((double) q[k].real, e), qi = ldexp((double) q[k].imag, e);
+		s += (double) X[k].real * X[k].real + (double) X[k].imag * X[k].imag;
+		d += (qr - X[k].real) * (qr - X[k].real) +
+				(qi - X[k].imag) * (qi - X[k].imag);
+	}
+	return 10 * log10(s / d);
+}
+
+// fft_q15() of the real signal xr against fft(), fails below SNR_BOUND(N)
+static void check_q15(const char *name, int N) {
+
+	for (int n = 0; n < N; n++)
+		x[n] = complex_num(xr[n], 0);
+	fft(X, x, N);
+	int e = q15_from_float(q, xr, NULL, N, 0);
+	if (fft_q15(q, N, &e) != 0)
+		failures++;
+
+	double r = snr(q, e, X, N);
+	bool ok = r > SNR_BOUND(N);
+	printf("%-10s %6d %9.1f dB %s\n", name, N, r, ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+}
+
+// Goertzel filters at 4 bins of the real signal xr against spectrum_psd()
+static void check_goertzel(int N) {
+
+	goertzel_t filters[4];
+	goertzel_bank_t bank;
+	goertzel_init(&bank, filters, 4, N, Fs);
+	for (int i = 0; i < 4; i++)
+		goertzel_add(&bank, (float) Fs * (1 + i * (N / 2 - 2) / 3) / N);
+	for (int n = 0; n < N; n++)
+		goertzel_update(&bank, xr[n]);
+
+	rfft(X, xr, N);
+	spectrum_psd(spectrum, Pxx, X, N, 2.0f / N, 2.0f / (Fs * N));
+
+	double em = 0, edb = 0;
+	for (int i = 0; i < 4; i++) {
+		int p = 2 * (filters[i].k - 1); // point of bin k
+		double m = goertzel_magnitude(&bank, i);
+		double d = goertzel_psd(&bank, i);
+		em = fmax(em, fabs(m - spectrum[p]) / spectrum[p]);
+		edb = fmax(edb, fabs(d - Pxx[p]));
+	}
+	bool ok = em < GOERTZEL_TOLERANCE && edb < GOERTZEL_DB;
+	printf("%-10s %6d %12.3g %9.3g dB %s\n", "goertzel", N, em, edb,
+			ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+}
+
+// reference dft() of x, which accumulates into its output
+static void reference(int N) {
+
+	memset(X, 0, N * sizeof(complex_t));
+	dft(X, x, N);
+}
+
+int main() {
+
+	srand(1);
+	printf("%-10s %6s %12s\n", "transform", "N", "error");
+	for (int N = NMIN; N <= NMAX; N *= 2) {
+		for (int n = 0; n < N; n++)
+			x[n] = complex_num(rand() / (float) RAND_MAX - 0.5f,
+					rand() / (float) RAND_MAX - 0.5f);
+		reference(N);
+
+		if (fft(Y, x, N) != 0)
+			failures++;
+		check("fft", N, error(Y, X, N), TOLERANCE);
+
+		// real signal, N/2+1 bins
+		for (int n = 0; n < N; n++) {
+			xr[n] = rand() / (float) RAND_MAX - 0.5f;
+			x[n] = complex_num(xr[n], 0);
+		}
+		reference(N);
+		if (rfft(Y, xr, N) != 0)
+			failures++;
+		check("rfft", N, error(Y, X, N / 2 + 1), TOLERANCE);
+
+		// windowed while packed, against the signal windowed beforehand
+		window_t win;
+		window_init(&win, w, WINDOW_HANN, N, 0);
+		for (int n = 0; n < N; n++)
+			x[n] = complex_num(xr[n] * w[n], 0);
+		reference(N);
+		if (rfftw(Y, xr, w, N) != 0)
+			failures++;
+		check("rfftw", N, error(Y, X, N / 2 + 1), TOLERANCE);
+
+		check_goertzel(N);
+
+		// Q15 of a random signal, and of a tone of full scale (bin N/8)
+		for (int n = 0; n < N; n++)
+			xr[n] = rand() / (float) RAND_MAX - 0.5f;
+		check_q15("q15 random", N);
+		for (int n = 0; n < N; n++)
+			xr[n] = cosf(2 * M_PI * n / 8);
+		check_q15("q15 tone", N);
+	}
+
+	if (failures != 0) {
+		printf("FAIL: %d checks\n", failures);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+/* layout_bench.cpp
+ *
+ * Host benchmark of the complex buffer layouts, which compares the FFT of
+ * an interleaved complex_t array (fft) with the FFT of a split-format
+ * buffer (fft_soa), and the cost of converting between them.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build -DMARCH_NATIVE=ON
+ *   cmake --build build --target layout_bench && build/layout_bench
+ */
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "complex_soa.h"
+#include "fft.h"
+#include <time.h>
+
+#define REPEAT_NS 200000000L // run every case for about 0.2 s
+
+static complex_t *x;      // input signal
+static complex_t *aos;
+static complex_soa_t xs;  // input signal (split)
+static complex_soa_t soa;
+
+// every transform starts from the input signal, so both cases include
+// copying it
+static void run_fft(int N) {
+
+	fft(aos, x, N);
+}
+
+static void run_fft_soa(int N) {
+
+	memcpy(soa.real, xs.real, N * sizeof(float));
+	memcpy(soa.imag, xs.imag, N * sizeof(float));
+	fft_soa(&soa, N);
+}
+
+static void run_convert(int N) {
+
+	complex_soa_from(&soa, aos, N);
+	complex_soa_to(aos, &soa, N);
+}
+
+static double now_ns() {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Time one case, returns ns per call
+static double run(void (*f)(int), int N) {
+
+	long calls = 0, batch = 1;
+	double t0 = now_ns(), t = t0;
+	while (t - t0 < REPEAT_NS) {
+		for (long i = 0; i < batch; i++)
+			f(N);
+		calls += batch;
+		batch *= 2;
+		t = now_ns();
+	}
+
+	return (t - t0) / calls;
+}
+
+int main() {
+
+	printf("%6s %14s %14s %14s %8s\n",
+			"N", "fft(ns)", "fft_soa(ns)", "convert(ns)", "speedup");
+
+	for (int N = 64; N <= 4096; N *= 4) {
+		x = (complex_t *) malloc(N * sizeof(complex_t));
+		aos = (complex_t *) malloc(N * sizeof(complex_t));
+		complex_soa_alloc(&xs, N);
+		complex_soa_alloc(&soa, N);
+
+		srand(N);
+		for (int n = 0; n < N; n++)
+			x[n] = complex_num(rand() / (float) RAND_MAX - 0.5f,
+					rand() / (float) RAND_MAX - 0.5f);
+		complex_soa_from(&xs, x, N);
+		memcpy(aos, x, N * sizeof(complex_t));
+
+		double t_aos = run(run_fft, N);
+		double t_soa = run(run_fft_soa, N);
+		double t_cvt = run(run_convert, N);
+		printf("%6d %14.1f %14.1f %14.1f %7.2fx\n",
+				N, t_aos, t_soa, t_cvt, t_aos / t_soa);
+
+		free(x);
+		free(aos);
+		complex_soa_free(&xs);
+		complex_soa_free(&soa);
+	}
+
+	return 0;
+}
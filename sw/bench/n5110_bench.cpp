@@ -0,0 +1,322 @@
+/* n5110_bench.cpp
+ *
+ * Host check of the asynchronous refresh of the N5110 driver over the
+ * simulated DMA (mbed_sim_spi_dma): frames of random pixels are drawn and
+ * refreshed by refreshAsync(), and the next frame is drawn while the
+ * transfer runs. A model of the PCD8544 on the SPI bus checks that every
+ * byte arrives while the display is selected, and the completion callback
+ * checks that the display RAM then holds the frame it was called for, i.e.
+ * that drawing the next frame does not leak into the transfer, and that the
+ * callbacks come once per frame and in order. The same frames are also
+ * refreshed by refresh() to compare the time the caller is blocked.
+ *
+ * The drawing primitives (drawLine, drawVLine, drawHLine, drawRect,
+ * clearRect and drawString) are checked against a per-pixel reference over
+ * random shapes, with ends off the display: the buffer must match the
+ * reference pixel for pixel, and after refresh() the display RAM must match
+ * the buffer, i.e. the primitives mark every column they change.
+ *
+ * The program exits with status 1 if there are errors.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target n5110_bench && build/n5110_bench
+ *
+ * With MBED_SIM_SPEED=1 the transfers take their time at the bus frequency,
+ * so that nearly every frame is drawn during the previous transfer.
+ */
+#include "mbed.h"
+#include "N5110.h"
+#include <time.h>
+
+#define FRAMES 2000 // per mode
+#define OPS    40   // drawing operations per frame
+#define SHAPES 20000 // primitives checked against the reference
+#define MARGIN 20   // pixels off the display of the random ends
+
+// pins of the display, as on the board
+#define LCD_SCE  p8
+#define LCD_DC   p10
+#define LCD_SCLK p13
+
+// PCD8544 in horizontal addressing, keeps the display RAM
+class CheckModel : public SimSPIDevice {
+public:
+
+	CheckModel() : x(0), y(0), extended(0), unselected(0) {
+		memset(ram, 0, sizeof(ram));
+	}
+
+	int write(int value, int bits) {
+		if (mbed_sim_pin_read(LCD_SCE)) {
+			unselected++; // byte out of a frame, lost by the display
+			return -1;
+		}
+		if (!mbed_sim_pin_read(LCD_DC)) {
+			if ((value & 0xE0) == 0x20)
+				extended = value & 1; // function set
+			else if ((value & 0x80) && !extended)
+				x = (value & 0x7F) % 84;
+			else if ((value & 0xC0) == 0x40 && !extended)
+				y = (value & 0x07) % 6;
+			return 0;
+		}
+		ram[y][x] = value;
+		if (++x == 84) {
+			x = 0;
+			y = (y + 1) % 6;
+		}
+		return 0;
+	}
+
+	unsigned char ram[6][84];
+	int x, y, extended;
+	volatile long unselected;
+};
+
+static CheckModel model;
+static N5110 display(p7, p8, p9, p10, p11, p13, p21);
+
+static unsigned char expected[84][6]; // frame of the transfer in progress
+static volatile long started, completed, errors;
+
+static bool matches() {
+
+	for (int i = 0; i < 84; i++)
+		for (int j = 0; j < 6; j++)
+			if (model.ram[j][i] != expected[i][j])
+				return false;
+	return true;
+}
+
+// completion of refreshAsync(), from the DMA thread
+static void done() {
+
+	if (++completed != started)
+		errors++; // missed or repeated callback
+	if (!matches())
+		errors++; // the RAM is not the frame of the transfer
+}
+
+static void draw() {
+
+	for (int k = 0; k < OPS; k++) {
+		int op = rand() % 16;
+		if (op < 8)
+			display.setPixel(rand() % 84, rand() % 48);
+		else if (op < 14)
+			display.clearPixel(rand() % 84, rand() % 48);
+		else if (op == 14)
+			display.buffer[rand() % 84][rand() % 6] = 0; // not marked
+		else if (rand() % 8 == 0)
+			display.clearBuffer();
+	}
+	for (int j = 0; j < 6; j++)
+		display.markDirty(0, 83, j);
+}
+
+static double now_ns() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run(const char *name, bool async) {
+
+	srand(1);
+	double blocked = 0;
+	int overlapped = 0; // frames drawn during the transfer of the previous one
+	unsigned long b0 = display.getSPIBytes();
+	for (int f = 0; f < FRAMES; f++) {
+		if (display.isRefreshing())
+			overlapped++;
+		draw(); // overlaps the transfer of the previous frame
+		display.waitRefresh(); // before expected is overwritten
+		memcpy(expected, display.buffer, sizeof(expected));
+		double t0 = now_ns();
+		if (async) {
+			started++;
+			display.refreshAsync(done);
+		} else
+			display.refresh();
+		blocked += now_ns() - t0;
+		if (!async && !matches())
+			errors++;
+	}
+	display.waitRefresh();
+	if (!matches())
+		errors++;
+
+	printf("%-8s %8.1f us blocked/frame %8.1f bytes/frame %6d overlapped "
+			"%6ld errors\n", name, blocked / FRAMES * 1e-3,
+			(double) (display.getSPIBytes() - b0) / FRAMES, overlapped, errors);
+}
+
+// Per-pixel reference of the primitives
+static bool ref[84][48];
+
+static void ref_pixel(int x, int y, bool set) {
+
+	if (x >= 0 && x < 84 && y >= 0 && y < 48)
+		ref[x][y] = set;
+}
+
+// Bresenham, a pixel at a time
+static void ref_line(int x0, int y0, int x1, int y1) {
+
+	int dx = abs(x1 - x0), dy = abs(y1 - y0);
+	int sx = (x1 > x0) ? 1 : -1, sy = (y1 > y0) ? 1 : -1;
+	int x = x0, y = y0;
+	if (dy > dx) {
+		int err = dy / 2;
+		for (;; y += sy) {
+			ref_pixel(x, y, true);
+			if (y == y1)
+				break;
+			err -= dx;
+			if (err < 0) {
+				x += sx;
+				err += dy;
+			}
+		}
+	} else {
+		int err = dx / 2;
+		for (;; x += sx) {
+			ref_pixel(x, y, true);
+			if (x == x1)
+				break;
+			err -= dy;
+			if (err < 0) {
+				y += sy;
+				err += dx;
+			}
+		}
+	}
+}
+
+static void ref_rect(int x, int y, int w, int h, bool fill, bool set) {
+
+	for (int i = x; i < x + w; i++)
+		for (int j = y; j < y + h; j++)
+			if (fill || i == x || i == x + w - 1 || j == y || j == y + h - 1)
+				ref_pixel(i, j, set);
+}
+
+static void ref_string(const char *str, int x, int y) {
+
+	for (; *str; str++, x += 6)
+		for (int i = 0; i < 5; i++)
+			for (int b = 0; b < 8; b++)
+				if (font5x7[(*str - 32) * 5 + i] & (1 << b))
+					ref_pixel(x + i, y + b, true);
+}
+
+// random coordinate of a size, up to MARGIN pixels off the display
+static int coordinate(int size) {
+
+	return rand() % (size + 2 * MARGIN) - MARGIN;
+}
+
+static void check_primitives() {
+
+	srand(1);
+	display.clearBuffer();
+	display.refresh();
+	memset(ref, 0, sizeof(ref));
+
+	long mismatches = 0;
+	for (int k = 0; k < SHAPES; k++) {
+		int x0 = coordinate(84), y0 = coordinate(48);
+		int x1 = coordinate(84), y1 = coordinate(48);
+		int w = rand() % 30 - 2, h = rand() % 30 - 2;
+		bool fill = rand() % 2;
+		char str[5];
+		switch (rand() % 7) {
+		case 0:
+			display.drawLine(x0, y0, x1, y1);
+			ref_line(x0, y0, x1, y1);
+			break;
+		case 1:
+			display.drawVLine(x0, y0, y1);
+			ref_line(x0, y0, x0, y1);
+			break;
+		case 2:
+			display.drawHLine(x0, x1, y0);
+			ref_line(x0, y0, x1, y0);
+			break;
+		case 3:
+			display.drawRect(x0, y0, w, h, fill);
+			ref_rect(x0, y0, w, h, fill, true);
+			break;
+		case 4:
+			display.clearRect(x0, y0, w, h);
+			ref_rect(x0, y0, w, h, true, false);
+			break;
+		case 5:
+			for (int i = 0; i < 4; i++)
+				str[i] = 32 + rand() % 96;
+			str[4] = 0;
+			display.drawString(str, x0, y0);
+			ref_string(str, x0, y0);
+			break;
+		default:
+			if (rand() % 8 == 0) {
+				display.clearBuffer();
+				memset(ref, 0, sizeof(ref));
+			}
+			break;
+		}
+
+		for (int i = 0; i < 84; i++)
+			for (int j = 0; j < 48; j++)
+				if (((display.buffer[i][j >> 3] >> (j & 7)) & 1) != ref[i][j])
+					mismatches++;
+		if (k % 16 == 15) {
+			memcpy(expected, display.buffer, sizeof(expected));
+			display.refresh();
+			if (!matches())
+				errors++; // a changed column was not marked
+		}
+	}
+	if (mismatches != 0)
+		errors++;
+
+	printf("%-8s %8d shapes %8ld pixels off the reference %6ld errors\n",
+			"shapes", SHAPES, mismatches, errors);
+}
+
+int main() {
+
+	mbed_sim_spi_attach(LCD_SCLK, &model);
+	display.init();
+
+	run("refresh", false);
+	run("async", true);
+
+	// the functions that write to the display wait for the transfer
+	display.randomiseBuffer();
+	memcpy(expected, display.buffer, sizeof(expected));
+	started++;
+	display.refreshAsync(done);
+	display.setXYAddress(10, 2);
+	display.printChar('A');
+	display.refresh();
+	if (!matches())
+		errors++;
+
+	check_primitives();
+
+	if (completed != started)
+		errors++;
+	if (model.unselected != 0) {
+		printf("%ld bytes out of a frame\n", model.unselected);
+		errors++;
+	}
+	if (errors != 0) {
+		printf("FAIL: %ld errors\n", errors);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,274 @@
+/* plot_check.cpp
+ *
+ * Host check of the Plot widget, drawn into the buffer of an N5110 on the
+ * simulated board (nothing is refreshed):
+ *
+ *  - decimation: setData() of more points than columns puts a spike in the
+ *    column of its point (n･c/cols to n･(c+1)/cols - 1), fewer points take
+ *    a column each, and non-finite points leave their column empty;
+ *  - scale: the automatic scale grows at once to fit the data, keeps its
+ *    size while they span more than the shrink fraction of it, and shrinks
+ *    once they span less;
+ *  - tick marks: one per step of the scale, also when the step is below
+ *    the resolution of its ends (e.g. data alternating between 1e7 and
+ *    1e7 + 1, a step of 0.5 that a float loop adding it to 1e7 never
+ *    passes);
+ *  - sweep: update() of a sweeping plot, which draws only the new columns,
+ *    the gap ahead of them and the labels over them, leaves the buffer as
+ *    draw() of the whole plot at the same scale does, with bursts of
+ *    appends, NaN samples (broken trace), the cursor wrapping, and the
+ *    scale growing and shrinking; the trace is broken at the wrap and after
+ *    the gap, and the scale shrinks once the cursor wraps.
+ *
+ * The program prints the result of every check and exits with status 1 if
+ * any check fails.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target plot_check && build/plot_check
+ */
+#include "mbed.h"
+#include "N5110.h"
+#include "Plot.h"
+#include <math.h>
+#include <string.h>
+
+#define POINTS 1000 // points of the decimation checks
+#define STEPS 3000  // updates of every sweep check
+
+static N5110 lcd(p7, p8, p9, p10, p11, p13, p21);
+static float points[POINTS];
+
+static int failures = 0;
+
+static void check(const char *name, bool ok) {
+
+	printf("%-40s %s\n", name, ok ? "ok" : "FAIL");
+	if (!ok)
+		failures++;
+}
+
+// pixels set in column x, rows y0 to y1
+static int pixels(int x, int y0, int y1) {
+
+	int n = 0;
+	for (int y = y0; y <= y1; y++)
+		if (lcd.getPixel(x, y))
+			n++;
+	return n;
+}
+
+// full-screen plot of the points with the scale 0 to 1 and no labels, the
+// row 0 is the top of the scale
+static void plot(int n) {
+
+	Plot p(&lcd);
+	p.setLabels(false);
+	p.setRange(0, 1);
+	p.setData(points, n);
+	lcd.clearBuffer();
+	p.draw();
+}
+
+// a spike at the first and at the last point of every column, more points
+// than columns
+static void check_decimation() {
+
+	int cols = 84 - PLOT_AXIS_WIDTH;
+	bool ok = true;
+	for (int c = 0; c < cols; c++) {
+		// column c spans the points n･c/cols to n･(c+1)/cols - 1
+		int ends[2] = { c * POINTS / cols, (c + 1) * POINTS / cols - 1 };
+		for (int e = 0; e < 2; e++) {
+			for (int k = 0; k < POINTS; k++)
+				points[k] = 0;
+			points[ends[e]] = 1;
+			plot(POINTS);
+			for (int x = PLOT_AXIS_WIDTH; x < 84; x++)
+				if ((lcd.getPixel(x, 0) != 0) != (x == PLOT_AXIS_WIDTH + c))
+					ok = false;
+		}
+	}
+	check("setData, spike in the column of its point", ok);
+
+	// fewer points than columns, a column each, the NaN and -inf points
+	// leave their columns empty
+	for (int k = 0; k < 10; k++)
+		points[k] = 0.5f;
+	points[3] = NAN;
+	points[6] = -INFINITY;
+	plot(10);
+	ok = true;
+	for (int c = 0; c < cols; c++) {
+		bool drawn = c < 10 && c != 3 && c != 6;
+		if ((pixels(PLOT_AXIS_WIDTH + c, 0, 47) != 0) != drawn)
+			ok = false;
+	}
+	check("setData, a column per point, NaN skipped", ok);
+}
+
+// automatic scale, with hysteresis
+static void check_scale() {
+
+	Plot p(&lcd);
+	p.setLabels(false);
+
+	for (int k = 0; k < 10; k++)
+		points[k] = k * 5; // 0 to 45
+	p.setData(points, 10);
+	p.draw();
+	float lo = p.getMin(), hi = p.getMax();
+	check("scale fits the data", lo <= 0 && hi >= 45 && hi - lo < 2 * 45);
+
+	for (int k = 0; k < 10; k++)
+		points[k] = k * 2; // 0 to 18, more than 1/4 of the scale
+	p.setData(points, 10);
+	p.draw();
+	check("scale kept above the shrink fraction",
+			p.getMin() == lo && p.getMax() == hi);
+
+	for (int k = 0; k < 10; k++)
+		points[k] = k * 0.5f; // 0 to 4.5, less than 1/4 of the scale
+	p.setData(points, 10);
+	p.draw();
+	check("scale shrunk below the shrink fraction",
+			p.getMax() - p.getMin() < (hi - lo) / 4 && p.getMax() >= 4.5f);
+
+	for (int k = 0; k < 10; k++)
+		points[k] = k * 20; // 0 to 180
+	p.setData(points, 10);
+	p.draw();
+	check("scale grown to fit the data", p.getMax() >= 180);
+}
+
+// tick marks of the scale, left of the axis
+static void check_ticks() {
+
+	Plot p(&lcd);
+	p.setLabels(false);
+	p.setRange(0, 2); // step 0.5
+	for (int k = 0; k < 10; k++)
+		points[k] = 0.5f;
+	p.setData(points, 10);
+	lcd.clearBuffer();
+	p.draw();
+	check("a tick mark per step", pixels(0, 0, 47) == 5);
+
+	// the scale 1e7 to 1e7 + 1, whose step 0.5 rounds away when added to
+	// 1e7, has a tick mark at both ends (the middle one rounds to an end)
+	Plot q(&lcd);
+	q.setLabels(false);
+	for (int k = 0; k < 40; k++)
+		points[k] = (k & 1) ? 1e7f + 1 : 1e7f;
+	q.setData(points, 40);
+	lcd.clearBuffer();
+	q.draw();
+	check("ticks below the resolution of the scale",
+			lcd.getPixel(0, 0) && lcd.getPixel(0, 47) && pixels(0, 0, 47) <= 3);
+}
+
+// a sweeping plot p at x, y, w by h updated after every burst of samples,
+// against a twin q that gets the same samples and is drawn whole at the scale
+// of p; true if the buffers match but for the tick marks (the step of q
+// follows from the range of p, that of p from its data)
+static bool sweep(int x, int y, int w, int h, bool range, bool labels) {
+
+	Plot p(&lcd, x, y, w, h), q(&lcd, x, y, w, h);
+	p.setSweep(true);
+	q.setSweep(true);
+	p.setSamplesPerColumn(3);
+	q.setSamplesPerColumn(3);
+	if (range)
+		p.setRange(0, 40);
+	p.setLabels(labels);
+	q.setLabels(labels);
+	lcd.clearBuffer();
+	p.draw();
+
+	unsigned char updated[84][6];
+	float v = 20;
+	bool ok = true;
+	for (int i = 0; i < STEPS; i++) {
+		int burst = (rand() % 7 == 0) ? rand() % 12 : 1;
+		for (int k = 0; k < burst; k++) {
+			// a walk, wider in the second half (the scale grows and shrinks)
+			v += (rand() % 201 - 100) * 0.01f * (i > STEPS / 2 ? 5 : 1);
+			if (rand() % 200 == 0)
+				v = NAN;
+			else if (v != v)
+				v = 20;
+			p.append(v);
+			q.append(v);
+		}
+		p.update();
+		memcpy(updated, lcd.buffer, sizeof(updated));
+
+		lcd.clearBuffer();
+		q.setRange(p.getMin(), p.getMax());
+		q.draw();
+		for (int c = 0; c < 84; c++)
+			if (c != x && c != x + 1
+					&& memcmp(updated[c], lcd.buffer[c], 6) != 0)
+				ok = false;
+		memcpy(lcd.buffer, updated, sizeof(updated));
+	}
+	return ok;
+}
+
+// sweeping plots, full-screen and inset, autoscaled and not, with labels
+// and without
+static void check_sweep() {
+
+	check("sweep, full screen", sweep(0, 0, 84, 48, false, true));
+	check("sweep, inset, no labels", sweep(5, 0, 60, 48, false, false));
+	check("sweep, fixed range", sweep(0, 9, 84, 30, true, true));
+	check("sweep, inset, fixed range", sweep(5, 9, 60, 30, true, true));
+
+	// a column per sample, all 0 but the samples 2 (in the gap once the
+	// cursor wraps) and cols (the slot 0 again) at 1: the slots 0 and 3 are
+	// a pixel each, not joined to the slots 80 and 2 on their left
+	int cols = 84 - PLOT_AXIS_WIDTH;
+	Plot p(&lcd);
+	p.setSweep(true);
+	p.setLabels(false);
+	p.setRange(0, 1);
+	lcd.clearBuffer();
+	for (int i = 0; i <= cols; i++) {
+		p.append((i == 2 || i == cols) ? 1 : 0);
+		p.update();
+	}
+	int x0 = PLOT_AXIS_WIDTH;
+	check("sweep, trace broken at the wrap and gap",
+			pixels(x0, 0, 47) == 1 && lcd.getPixel(x0, 0)
+			&& pixels(x0 + 1, 0, 47) == 0 && pixels(x0 + 2, 0, 47) == 0
+			&& pixels(x0 + 3, 0, 47) == 1 && lcd.getPixel(x0 + 3, 47));
+
+	// samples 0 to 100 for a sweep, then 0 to 1 for more than a sweep
+	Plot q(&lcd);
+	q.setSweep(true);
+	q.setLabels(false);
+	lcd.clearBuffer();
+	for (int i = 0; i < 3 * cols; i++) {
+		q.append((i % 2) * (i < cols ? 100 : 1));
+		q.update();
+	}
+	check("sweep, scale shrunk after the wrap", q.getMax() - q.getMin() < 10);
+}
+
+int main() {
+
+	srand(1);
+	lcd.init();
+
+	check_decimation();
+	check_scale();
+	check_ticks();
+	check_sweep();
+
+	if (failures != 0) {
+		printf("FAIL: %d checks\n", failures);
+		return 1;
+	}
+	return 0;
+}
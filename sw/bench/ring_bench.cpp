@@ -0,0 +1,120 @@
+/* ring_bench.cpp
+ *
+ * Host stress test and benchmark of the SPSC ring buffer (ring_buffer.h):
+ * a producer thread pushes a sequence of numbers as fast as it can while a
+ * consumer thread drains it, and the consumer checks that every number
+ * arrives once and in order. It runs element by element (push, pop) and in
+ * place (reserve/commit, peek/consume), and exits with status 1 on the first
+ * lost, repeated or reordered element.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target ring_bench && build/ring_bench
+ */
+#include "mbed.h"
+#include "ring_buffer.h"
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define COUNT (1 << 24) // elements per case
+#define SIZE  1024      // ring capacity
+
+static dsp::ring_buffer<uint32_t, SIZE> ring;
+
+static bool in_place;         // reserve/commit, peek/consume
+static volatile long full;    // producer found the ring full
+static volatile long errors;  // elements out of sequence
+
+static void *producer(void *arg) {
+
+	uint32_t next = 0;
+	while (next < COUNT) {
+		if (in_place) {
+			uint32_t n;
+			uint32_t *p = ring.reserve(&n);
+			if (n > COUNT - next)
+				n = COUNT - next;
+			for (uint32_t i = 0; i < n; i++)
+				p[i] = next + i;
+			ring.commit(n);
+			next += n;
+			if (n == 0) {
+				full++;
+				sched_yield();
+			}
+		} else if (ring.push(next))
+			next++;
+		else {
+			full++;
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void *consumer(void *arg) {
+
+	uint32_t expected = 0;
+	while (expected < COUNT) {
+		if (in_place) {
+			uint32_t n;
+			const uint32_t *p = ring.peek(&n);
+			for (uint32_t i = 0; i < n; i++)
+				if (p[i] != expected++)
+					errors++;
+			ring.consume(n);
+			if (n == 0)
+				sched_yield();
+		} else {
+			uint32_t x;
+			if (ring.pop(&x)) {
+				if (x != expected++)
+					errors++;
+			} else
+				sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static double now_ns() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run(const char *name, bool mode) {
+
+	pthread_t p, c;
+	in_place = mode;
+	full = errors = 0;
+
+	double t0 = now_ns();
+	pthread_create(&c, NULL, consumer, NULL);
+	pthread_create(&p, NULL, producer, NULL);
+	pthread_join(p, NULL);
+	pthread_join(c, NULL);
+	double t = now_ns() - t0;
+
+	printf("%-14s %8.1f Msamples/s %10ld full %6ld errors\n", name,
+			COUNT / t * 1e3, full, errors);
+}
+
+int main() {
+
+	printf("%d samples, capacity %d\n", COUNT, SIZE);
+	run("push/pop", false);
+	if (errors != 0)
+		return 1;
+	run("peek/consume", true);
+	if (errors != 0)
+		return 1;
+	if (ring.size() != 0) {
+		printf("ring not empty\n");
+		return 1;
+	}
+	return 0;
+}
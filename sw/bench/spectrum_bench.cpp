@@ -0,0 +1,92 @@
+/* spectrum_bench.cpp
+ *
+ * Host micro-benchmark of the spectrum and PSD post-processing, which
+ * compares the original loops of computeDFT()/computePSD() (four norms and
+ * a pow() per output pair, 20･log10) with the fused spectrum_psd() stage.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target spectrum_bench && build/spectrum_bench
+ */
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "spectrum.h"
+#include <time.h>
+
+#define REPEAT_NS 200000000L // run every case for about 0.2 s
+
+// Original post-processing, spectrum and PSD loops
+static void postprocess_orig(float *spectrum, float *Pxx, complex_t *X, int N) {
+
+	for (int n = 0; n < N; n++)
+		spectrum[n] = 0;
+	for (int n = 0; n < floor(N / 2) - 1; n++) {
+		spectrum[2 * n] = complex_norm(X[n + 1]);
+		spectrum[2 * n + 1] =
+				(complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
+	}
+
+	for (int n = 0; n < N; n++) Pxx[n] = 0; // init to 0
+	for (int n = 0; n < floor(N / 2) - 1; n++) {
+		Pxx[2 * n] = 20 * log10(pow(complex_norm(X[n + 1]), 2));
+		float avg = (complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
+		Pxx[2 * n + 1] = 20 * log10(pow(avg, 2));
+	}
+}
+
+// Fused post-processing
+static void postprocess_fused(float *spectrum, float *Pxx, complex_t *X, int N) {
+
+	spectrum_psd(spectrum, Pxx, X, N, 1, 1);
+}
+
+static double now_ns() {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Time one post-processing function, returns ns per call
+static double run(void (*f)(float *, float *, complex_t *, int),
+		float *spectrum, float *Pxx, complex_t *X, int N) {
+
+	long calls = 0, batch = 1;
+	double t0 = now_ns(), t = t0;
+	while (t - t0 < REPEAT_NS) {
+		for (long i = 0; i < batch; i++)
+			f(spectrum, Pxx, X, N);
+		calls += batch;
+		batch *= 2;
+		t = now_ns();
+	}
+
+	return (t - t0) / calls;
+}
+
+int main() {
+
+	printf("%6s %14s %14s %8s\n", "N", "original(ns)", "fused(ns)", "speedup");
+
+	for (int N = 64; N <= 4096; N *= 4) {
+		complex_t *X = (complex_t *) malloc((N / 2 + 1) * sizeof(complex_t));
+		float *spectrum = (float *) malloc(N * sizeof(float));
+		float *Pxx = (float *) malloc(N * sizeof(float));
+
+		srand(N);
+		for (int k = 0; k <= N / 2; k++)
+			X[k] = complex_num(rand() / (float) RAND_MAX - 0.5f,
+					rand() / (float) RAND_MAX - 0.5f);
+
+		double orig = run(postprocess_orig, spectrum, Pxx, X, N);
+		double fused = run(postprocess_fused, spectrum, Pxx, X, N);
+		printf("%6d %14.1f %14.1f %7.2fx\n", N, orig, fused, orig / fused);
+
+		free(X);
+		free(spectrum);
+		free(Pxx);
+	}
+
+	return 0;
+}
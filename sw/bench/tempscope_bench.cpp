@@ -0,0 +1,106 @@
+/* tempscope_bench.cpp
+ *
+ * Host check of the steady state of TempScope on the simulated board: the
+ * acquisition runs at DAQ_HZ, in block and in sliding DFT mode, and every
+ * call of malloc, calloc, realloc and operator new is counted (they are
+ * wrapped at link time, see CMakeLists.txt). After a warm-up,
+ * the buffers come from the arena carved by enable(), so the run must not
+ * allocate at all; the program exits with status 1 if it does, or if no
+ * results were published.
+ *
+ * Build and run on the host (from sw/, see CMakeLists.txt):
+ *
+ *   cmake -S . -B build
+ *   cmake --build build --target tempscope_bench && build/tempscope_bench
+ *
+ * MBED_SIM_SPEED=0 runs it in virtual time (see host/mbed_sim.h).
+ */
+#include "mbed.h"
+#include "rtos.h"
+#include "TempScope.h"
+
+#define DAQ_HZ   1000 // acquisition rate
+#define N        TEMPSCOPE_MAX_SAMPLES // samples, the whole arena
+#define WARM_UP  0.1  // s, before counting (first DFT, thread start)
+#define RUN      1.0  // s, per mode
+
+// Heap allocations, counted by the wrappers of malloc, calloc and realloc
+static volatile long allocs = 0;
+
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t n, size_t size);
+extern "C" void *__real_realloc(void *p, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size) {
+
+	__sync_fetch_and_add(&allocs, 1);
+	return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size) {
+
+	__sync_fetch_and_add(&allocs, 1);
+	return __real_calloc(n, size);
+}
+
+extern "C" void *__wrap_realloc(void *p, size_t size) {
+
+	__sync_fetch_and_add(&allocs, 1);
+	return __real_realloc(p, size);
+}
+
+// operator new(size_t) and operator new[](size_t) of the C++ library, which
+// call malloc from inside the library
+extern "C" void *__real__Znwm(size_t size);
+extern "C" void *__real__Znam(size_t size);
+
+extern "C" void *__wrap__Znwm(size_t size) {
+
+	__sync_fetch_and_add(&allocs, 1);
+	return __real__Znwm(size);
+}
+
+extern "C" void *__wrap__Znam(size_t size) {
+
+	__sync_fetch_and_add(&allocs, 1);
+	return __real__Znam(size);
+}
+
+// Run one mode, returns the allocations of its steady state
+static long run(TempScope &scope, const char *name, bool sliding) {
+
+	scope.setSlidingDFT(sliding);
+	if (!scope.enable()) {
+		printf("%-8s the arena is too small\n", name);
+		return -1;
+	}
+	wait(WARM_UP);
+
+	long a0 = allocs;
+	uint32_t s0 = scope.getSequence();
+	unsigned o0 = scope.getOverruns();
+	wait(RUN);
+	long a = allocs - a0;
+	uint32_t results = scope.getSequence() - s0;
+	unsigned overruns = scope.getOverruns() - o0;
+
+	scope.disable();
+	printf("%-8s %6u results %6u overruns %6ld allocations\n", name,
+			(unsigned) results, overruns, a);
+	return (results == 0) ? -1 : a;
+}
+
+int main() {
+
+	TempScope scope(new TMP102(0x48, p28, p27)); // arena on the stack
+	scope.setAqcuisitionFrequencyInHz(DAQ_HZ);
+	scope.setNumberOfSamples(N);
+
+	long block = run(scope, "block", false);
+	long sliding = run(scope, "sliding", true);
+	if (block != 0 || sliding != 0) {
+		printf("FAIL: the steady state allocates or publishes no results\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,64 @@
+/* arena.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the arena, a bump
+ * allocator on a static block of memory [2].
+ *
+ * Dependencies:
+ *  "stddef.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Hanson, D. R., "Fast allocation and deallocation of memory based on
+ *      object lifetimes," Software: Practice and Experience, vol. 20, no. 1,
+ *      pp. 5-12, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "arena.h"
+
+// Arena initialisation
+void arena_init(
+  arena_t *a,          // arena.
+  void *memory,        // memory block.
+  size_t size) {       // size of the block (bytes).
+
+  size_t skip = (ARENA_ALIGN - (size_t) memory % ARENA_ALIGN) % ARENA_ALIGN;
+
+  if (memory == NULL || size < skip)
+    skip = size = 0;
+
+  a->base = (unsigned char *) memory + skip;
+  a->size = size - skip;
+  a->used = 0;
+}
+
+
+// Carve a buffer of n bytes
+void *arena_alloc(
+  arena_t *a,          // arena.
+  size_t n) {          // size of the buffer (bytes).
+
+  void *p;
+
+  n = ARENA_SIZE(n);
+  if (n > a->size - a->used)
+    return NULL;
+
+  p = a->base + a->used;
+  a->used += n;
+  return p;
+}
+
+
+// Release all the buffers
+void arena_reset(arena_t *a) {
+
+  a->used = 0;
+}
@@ -0,0 +1,71 @@
+/* arena.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of an arena, a bump allocator on
+ * a static block of memory. Buffers are carved out of the block in order and
+ * are all released together by resetting the arena, so that a module sizes
+ * its buffers once (e.g. at configuration time) and never allocates from
+ * the heap afterwards: there is no fragmentation and no allocation time in
+ * the processing loop.
+ *
+ * Arena is defined as structure and is associated with the user defined
+ * type:
+ *
+ *                arena_t
+ *
+ * Dependencies:
+ *  "stddef.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Hanson, D. R., "Fast allocation and deallocation of memory based on
+ *      object lifetimes," Software: Practice and Experience, vol. 20, no. 1,
+ *      pp. 5-12, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_ARENA_H_
+#define __C90_ARENA_H_
+
+#include <stddef.h>
+
+// Alignment of the buffers (bytes), enough for double and complex_t
+#define ARENA_ALIGN 8
+
+// Size of a buffer of n bytes in the arena, including its alignment
+#define ARENA_SIZE(n) (((n) + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1))
+
+// Arena
+typedef struct {
+  unsigned char *base; // memory block, aligned to ARENA_ALIGN.
+  size_t size;         // size of the block (bytes).
+  size_t used;         // bytes carved out.
+} arena_t;
+
+
+// Arena initialisation on a block of memory, the start of the block is
+// skipped up to the alignment
+void arena_init(
+  arena_t *a,          // arena.
+  void *memory,        // memory block.
+  size_t size);        // size of the block (bytes).
+
+
+// Carve a buffer of n bytes, aligned to ARENA_ALIGN, O(1)
+// Returns the buffer, or NULL if the arena is full.
+void *arena_alloc(
+  arena_t *a,          // arena.
+  size_t n);           // size of the buffer (bytes).
+
+
+// Release all the buffers
+void arena_reset(arena_t *a);
+
+
+#endif // __C90_ARENA_H_
@@ -5,7 +5,11 @@
  * Created on Thu 20 Nov 2014
  *
  * This header file contains the definition of the complex number and the
- * declarations of the basic complex operations.
+ * basic complex operations.
+ *
+ * The operations are inline thin wrappers around the operations of the
+ * complex template (see complex_template.h), so that calls in the loops of
+ * the transforms are inlined.
  *
  * Complex type is defined as structure
  *
@@ -36,13 +40,13 @@
  *  Print complex number    | complex_print(c)          | N/A       | complex_t
  *
  * Dependencies:
- *  "math.h", ANSI C90
+ *  "complex_template.h", "math.h", ANSI C90
  *
  * References:
  *  [1] ISO/IEC, "Programming Languages�C (ISO/IEC 9899:1990)," Geneva,
  *      Switzerland: ISO, 1990.
  * 
- * Last modified on Sat 22 Nov 2014
+ * Last modified on Fri 16 Oct 2026
  *
  * Copyright by Petros Fountas. All rights reserved.
  */
@@ -50,6 +54,7 @@
 #define __C90_COMPLEX_NUMBERS_H_
 
 #include "mbed.h"
+#include "complex_template.h"
 
 // Print complex number to stdout
 #define complex_print(c) \
@@ -61,10 +66,7 @@
  *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexNumber.html 
  */
-typedef struct {
-  float real;
-  float imag;
-} complex_t;
+typedef dsp::complex<float> complex_t;
 
 
 /* Complex Number c = a + bi
@@ -73,7 +75,10 @@ typedef struct {
  *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexNumber.html 
  */
-complex_t complex_num(float a, float b);
+inline complex_t complex_num(float a, float b) {
+
+  return dsp::make_complex(a, b);
+}
 
 
 /* Real part Re(c)
@@ -82,7 +87,10 @@ complex_t complex_num(float a, float b);
  *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexNumber.html 
  */
-float complex_real(complex_t c);
+inline float complex_real(complex_t c) {
+
+  return c.real;
+}
 
 
 /* Imaginary part Im(c)
@@ -91,7 +99,10 @@ float complex_real(complex_t c);
  *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexNumber.html 
  */
-float complex_imag(complex_t c);
+inline float complex_imag(complex_t c) {
+
+  return c.imag;
+}
 
 
 /* Complex Norm z = norm(c)
@@ -100,7 +111,10 @@ float complex_imag(complex_t c);
  *  [1]  Weisstein, Eric W. "Complex Modulus." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexModulus.html  
  */
-float complex_norm(complex_t c);
+inline float complex_norm(complex_t c) {
+
+  return dsp::abs(c);
+}
 
 
 /* Complex Phase phi = phase(c)
@@ -109,7 +123,10 @@ float complex_norm(complex_t c);
  *  [1]  Weisstein, Eric W. "Phasor." From MathWorld--A Wolfram Web Resource.
  *       http://mathworld.wolfram.com/Phasor.html  
  */
-float complex_phase(complex_t c);
+inline float complex_phase(complex_t c) {
+
+  return dsp::arg(c);
+}
 
 /* Complex Conjugate a-bi = conj(a+bi)
  *
@@ -117,7 +134,10 @@ float complex_phase(complex_t c);
  *  [1]  Weisstein, Eric W. "Complex Conjugate." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexConjugate.html 
  */
-complex_t complex_conj(complex_t c);
+inline complex_t complex_conj(complex_t c) {
+
+  return dsp::conj(c);
+}
 
 
 /* Complex Exponential z = exp(c)
@@ -128,7 +148,10 @@ complex_t complex_conj(complex_t c);
  *  [2]  Weisstein, Eric W. "Complex Exponentiation." From MathWorld--A Wolfram
  *       Web Resource. http://mathworld.wolfram.com/ComplexExponentiation.html 
  */
-complex_t complex_exp(complex_t c);
+inline complex_t complex_exp(complex_t c) {
+
+  return dsp::exp(c);
+}
 
 
 /* Complex Addition c = a + b
@@ -137,7 +160,10 @@ complex_t complex_exp(complex_t c);
  *  [1]  Weisstein, Eric W. "Complex Addition." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexAddition.html 
  */
-complex_t complex_add(complex_t a, complex_t b);
+inline complex_t complex_add(complex_t a, complex_t b) {
+
+  return a + b;
+}
 
 
 /* Complex Subtraction c = a - b
@@ -146,7 +172,10 @@ complex_t complex_add(complex_t a, complex_t b);
  *  [1]  Weisstein, Eric W. "Complex Subtraction." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexSubtraction.html 
  */
-complex_t complex_sub(complex_t a, complex_t b);
+inline complex_t complex_sub(complex_t a, complex_t b) {
+
+  return a - b;
+}
 
 
 /* Complex Multiplication c = a * b
@@ -155,7 +184,10 @@ complex_t complex_sub(complex_t a, complex_t b);
  *  [1]  Weisstein, Eric W. "Complex Multiplication." From MathWorld--A Wolfram
  *       Web Resource. http://mathworld.wolfram.com/ComplexMultiplication.html 
  */
-complex_t complex_mul(complex_t a, complex_t b);
+inline complex_t complex_mul(complex_t a, complex_t b) {
+
+  return a*b;
+}
 
 
 /* Complex Division c = a / b
@@ -164,6 +196,9 @@ complex_t complex_mul(complex_t a, complex_t b);
  *  [1]  Weisstein, Eric W. "Complex Division." From MathWorld--A Wolfram Web
  *       Resource. http://mathworld.wolfram.com/ComplexDivision.html 
  */
-complex_t complex_div(complex_t a, complex_t b);
+inline complex_t complex_div(complex_t a, complex_t b) {
+
+  return a/b;
+}
 
 #endif // __C90_COMPLEX_NUMBERS_H_
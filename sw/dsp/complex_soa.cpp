@@ -0,0 +1,240 @@
+/* complex_soa.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the split-format complex
+ * buffer and of its DFT and FFT kernels.
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", "fft.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 723-737.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "complex_soa.h"
+
+// Per-stage twiddle tables of an FFT size, stage m = 2, 4, ..., N holds
+// W(m)^j, 0 ≤ j ≤ m/2-1, at offset m/2-1 (N-1 factors in total)
+static struct {
+  int N;
+  float *real;
+  float *imag;
+} cache[COMPLEX_SOA_CACHE];
+
+
+// Align a pointer up to COMPLEX_SOA_ALIGN bytes
+static float *align(void *p) {
+
+  uintptr_t a = ((uintptr_t) p + COMPLEX_SOA_ALIGN - 1) &
+                ~(uintptr_t) (COMPLEX_SOA_ALIGN - 1);
+
+  return (float *) a;
+}
+
+
+// Per-stage twiddle tables, built on first use
+static int stage_twiddles(
+  int N,           // FFT size (power of two).
+  float **real,    // real parts, float[N-1].
+  float **imag) {  // imaginary parts, float[N-1].
+
+  int i,j,m;
+
+  for (i = 0; i < COMPLEX_SOA_CACHE; i++) {
+    if (cache[i].N == N) {
+      *real = cache[i].real;
+      *imag = cache[i].imag;
+      return 0;
+    }
+    if (cache[i].N == 0)
+      break;
+  }
+  if (i == COMPLEX_SOA_CACHE)
+    return -1; // cache is full
+
+  // build tables once
+  float *w = (float *) malloc(2*N*sizeof(float));
+  if (w == NULL)
+    return -1;
+  for (m = 2; m <= N; m <<= 1) {
+    int half = m >> 1;
+    for (j = 0; j < half; j++) {
+      complex_t t = twiddle(N, j*(N/m)); // W(m)^j = W(N)^(j*N/m)
+      w[half - 1 + j] = t.real;
+      w[N + half - 1 + j] = t.imag;
+    }
+  }
+
+  cache[i].real = *real = w;
+  cache[i].imag = *imag = w + N;
+  cache[i].N = N;
+
+  return 0;
+}
+
+
+// Butterflies of a group, a[j] ± W(m)^j･b[j], 0 ≤ j ≤ m/2-1
+// The arrays never overlap (restrict) and are read with unit stride, so the
+// loop can be vectorised.
+static void butterflies(
+  float *__restrict__ ar,       // upper half, real parts.
+  float *__restrict__ ai,       // upper half, imaginary parts.
+  float *__restrict__ br,       // lower half, real parts.
+  float *__restrict__ bi,       // lower half, imaginary parts.
+  const float *__restrict__ tr, // W(m)^j, real parts.
+  const float *__restrict__ ti, // W(m)^j, imaginary parts.
+  int half) {                   // m/2.
+
+  int j;
+
+  for (j = 0; j < half; j++) {
+    float t_r = tr[j]*br[j] - ti[j]*bi[j];
+    float t_i = tr[j]*bi[j] + ti[j]*br[j];
+    br[j] = ar[j] - t_r;
+    bi[j] = ai[j] - t_i;
+    ar[j] += t_r;
+    ai[j] += t_i;
+  }
+}
+
+
+// Allocate a buffer of N elements
+int complex_soa_alloc(
+  complex_soa_t *z, // complex buffer.
+  int N) {          // number of elements.
+
+  int n;
+
+  // two arrays, each one rounded up to the alignment
+  int stride = (N*sizeof(float) + COMPLEX_SOA_ALIGN - 1) /
+               COMPLEX_SOA_ALIGN*COMPLEX_SOA_ALIGN;
+  z->mem = malloc(2*stride + COMPLEX_SOA_ALIGN);
+  if (z->mem == NULL)
+    return -1;
+
+  z->N = N;
+  z->real = align(z->mem);
+  z->imag = (float *) ((char *) z->real + stride);
+  for (n = 0; n < N; n++)
+    z->real[n] = z->imag[n] = 0;
+
+  return 0;
+}
+
+
+// Release a buffer
+void complex_soa_free(complex_soa_t *z) {
+
+  free(z->mem);
+  z->mem = NULL;
+  z->real = z->imag = NULL;
+  z->N = 0;
+}
+
+
+// Conversion from complex_t
+void complex_soa_from(
+  complex_soa_t *z,   // output buffer.
+  const complex_t *x, // input array.
+  int N) {            // number of elements.
+
+  int n;
+
+  for (n = 0; n < N; n++) {
+    z->real[n] = x[n].real;
+    z->imag[n] = x[n].imag;
+  }
+}
+
+
+// Conversion to complex_t
+void complex_soa_to(
+  complex_t *x,           // output array.
+  const complex_soa_t *z, // input buffer.
+  int N) {                // number of elements.
+
+  int n;
+
+  for (n = 0; n < N; n++) {
+    x[n].real = z->real[n];
+    x[n].imag = z->imag[n];
+  }
+}
+
+
+// Discrete Fourier Transform (direct implementation)
+void dft_soa(
+  complex_soa_t *X,       // DFT output of the signal.
+  const complex_soa_t *x, // input signal.
+  int N) {                // DFT size (number of samples).
+
+  int k,n;
+  const float *xr = x->real;
+  const float *xi = x->imag;
+
+  // 0 ≤ k ≤ N-1
+  for (k = 0; k < N; k++) {
+    float yr = 0, yi = 0;
+    int kn = 0; // k*n mod N, since W(N)^(k*n) is periodic in N
+    // 0 ≤ n ≤ N-1
+    for (n = 0; n < N; n++) {
+      // X[k] = ∑ x[n]･W(N)^(k*n), W(N) = exp(-j･2𝜋/N)
+      complex_t w = twiddle(N, kn);
+      yr += xr[n]*w.real - xi[n]*w.imag;
+      yi += xr[n]*w.imag + xi[n]*w.real;
+      kn += k;
+      if (kn >= N)
+        kn -= N;
+    }
+    X->real[k] = yr;
+    X->imag[k] = yi;
+  }
+}
+
+
+// Fast Fourier Transform (iterative radix-2 decimation-in-time, in-place)
+int fft_soa(
+  complex_soa_t *x, // input signal, FFT output on return.
+  int N) {          // FFT size (number of samples, power of two).
+
+  int i,j,k,m;
+  float *re = x->real;
+  float *im = x->imag;
+  float *wr, *wi;
+
+  if (!is_pow2(N) || stage_twiddles(N, &wr, &wi) != 0)
+    return -1;
+
+  // bit-reversed reordering, x[i] <-> x[rev(i)]
+  for (i = 1, j = 0; i < N; i++) {
+    int bit = N >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      float t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+
+  // log2(N) butterfly stages, m = 2, 4, ..., N
+  for (m = 2; m <= N; m <<= 1) {
+    int half = m >> 1;
+
+    // every group of m elements, W(m)^j at offset m/2-1
+    for (k = 0; k < N; k += m)
+      butterflies(re + k, im + k, re + k + half, im + k + half,
+                  wr + half - 1, wi + half - 1, half);
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* complex_soa.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the split-format
+ * (structure-of-arrays) complex buffer, and of the DFT and FFT kernels that
+ * operate on it.
+ *
+ * A complex_t array interleaves the real and imaginary parts, { re, im, re,
+ * im, ... }. The split format keeps them in two separate arrays, so that the
+ * inner loops of the kernels read and write consecutive floats of the same
+ * kind, which the compiler can vectorise (e.g. SSE/AVX on a host build).
+ * Both arrays are aligned to COMPLEX_SOA_ALIGN bytes.
+ *
+ * The FFT reads its twiddle factors from per-stage tables, W(m)^j,
+ * 0 ≤ j ≤ m/2-1, which are contiguous and split as well. These are built on
+ * first use from the twiddle tables and kept for the lifetime of the program
+ * (up to COMPLEX_SOA_CACHE sizes).
+ *
+ * Complex buffer is defined as structure
+ *
+ *      { N: int, real: float*, imag: float* }
+ *
+ * and is associated with the user defined type:
+ *
+ *                complex_soa_t
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", "fft.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 723-737.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_COMPLEX_SOA_H_
+#define __C90_COMPLEX_SOA_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "twiddle.h"
+#include "fft.h"
+
+// Alignment of the real and imaginary arrays (bytes, AVX register size)
+#define COMPLEX_SOA_ALIGN 32
+
+// Maximum number of FFT sizes with per-stage twiddle tables
+#define COMPLEX_SOA_CACHE 4
+
+// Split-format complex buffer
+typedef struct {
+  int N;       // number of elements.
+  float *real; // real parts, float[N], aligned.
+  float *imag; // imaginary parts, float[N], aligned.
+  void *mem;   // allocated memory.
+} complex_soa_t;
+
+
+// Allocate a buffer of N elements, initialised to 0
+// Returns 0 on success, -1 if out of memory.
+int complex_soa_alloc(
+  complex_soa_t *z, // complex buffer.
+  int N);           // number of elements.
+
+
+// Release a buffer
+void complex_soa_free(complex_soa_t *z);
+
+
+// Conversion from complex_t, z[n] = x[n], 0 ≤ n ≤ N-1
+void complex_soa_from(
+  complex_soa_t *z,   // output buffer.
+  const complex_t *x, // input array.
+  int N);             // number of elements.
+
+
+// Conversion to complex_t, x[n] = z[n], 0 ≤ n ≤ N-1
+void complex_soa_to(
+  complex_t *x,           // output array.
+  const complex_soa_t *z, // input buffer.
+  int N);                 // number of elements.
+
+
+// Discrete Fourier Transform (direct implementation)
+// X must not be the same buffer as x.
+void dft_soa(
+  complex_soa_t *X,       // DFT output of the signal.
+  const complex_soa_t *x, // input signal.
+  int N);                 // DFT size (number of samples).
+
+
+// Fast Fourier Transform (iterative radix-2 decimation-in-time, in-place)
+// Returns 0 on success, -1 if N is not a power of two or the per-stage
+// twiddle tables cannot be built (cache full or out of memory).
+int fft_soa(
+  complex_soa_t *x, // input signal, FFT output on return.
+  int N);           // FFT size (number of samples, power of two).
+
+
+#endif // __C90_COMPLEX_SOA_H_
@@ -0,0 +1,291 @@
+/* complex_template.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the complex number as a
+ * template of its scalar type, and of the complex operations as inline
+ * functions and operators, so that the compiler can inline them into the
+ * loops of the transforms (the C API of complex_numbers.h is a set of thin
+ * wrappers around them).
+ *
+ * Complex type is defined as structure
+ *
+ *      { real: T, imag: T }
+ *
+ * and is associated with the user defined type:
+ *
+ *                dsp::complex<T>
+ *
+ * It is an aggregate, so it can be initialised as { re, im } and it has the
+ * layout of the C structure, e.g. complex_t is dsp::complex<float> and
+ * complex_q15_t is dsp::complex<q15_t>.
+ *
+ * The following operations are supported:
+ *
+ *  Supported Operations   | Usage                 | float, double | q15_t
+ *  ---------------------------------------------------------------------------
+ *  Complex Number         | c = make_complex(a,b) | yes           | yes
+ *  Add., Subtr., Negation | a + b, a - b, -a      | yes           | yes (wraps)
+ *  Multiplication         | a*b, a*s              | yes           | yes (Q15)
+ *  Division               | a/b                   | yes           | no
+ *  Compound assignment    | +=, -=, *=            | yes           | yes
+ *  Conjugate              | conj(c)               | yes           | yes
+ *  Squared Norm           | norm_sq(c)            | T             | uint32_t, Q30
+ *  Norm                   | abs(c)                | T             | uint32_t, approx.
+ *  Phase (radians)        | arg(c)                | T             | no
+ *  Exponential            | exp(c)                | yes           | no
+ *
+ * The q15_t (int16_t) operations are overloads in integer arithmetic: the
+ * product is rounded and saturated to Q15, addition and subtraction wrap
+ * (the callers keep a headroom, see fft_q15), and the norm is approximated
+ * as max(a, 7/8･a + 1/2･b), a = max, b = min [2].
+ *
+ * Dependencies:
+ *  "math.h", "stdint.h", ANSI C99
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] Lyons, R. G., "Understanding Digital Signal Processing," 3rd ed.,
+ *      Prentice Hall, 2011, pp. 756-762.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_COMPLEX_TEMPLATE_H_
+#define __CPP98_COMPLEX_TEMPLATE_H_
+
+#include <math.h>
+#include <stdint.h>
+
+namespace dsp {
+
+/* Complex Type
+ *
+ * References:
+ *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
+ *       Resource. http://mathworld.wolfram.com/ComplexNumber.html
+ */
+template <typename T>
+struct complex {
+  T real;
+  T imag;
+};
+
+
+// Complex Number c = a + bi
+template <typename T>
+inline complex<T> make_complex(T a, T b) {
+
+  complex<T> c = {a, b};
+
+  return c;
+}
+
+
+// Complex Addition c = a + b
+template <typename T>
+inline complex<T> operator+(const complex<T> &a, const complex<T> &b) {
+
+  return make_complex<T>(a.real + b.real, a.imag + b.imag);
+}
+
+
+// Complex Subtraction c = a - b
+template <typename T>
+inline complex<T> operator-(const complex<T> &a, const complex<T> &b) {
+
+  return make_complex<T>(a.real - b.real, a.imag - b.imag);
+}
+
+
+// Complex Negation c = -a
+template <typename T>
+inline complex<T> operator-(const complex<T> &a) {
+
+  return make_complex<T>(-a.real, -a.imag);
+}
+
+
+// Complex Multiplication c = a * b
+template <typename T>
+inline complex<T> operator*(const complex<T> &a, const complex<T> &b) {
+
+  return make_complex<T>(a.real*b.real - a.imag*b.imag,
+                         a.real*b.imag + a.imag*b.real);
+}
+
+
+// Scalar Multiplication c = a * s
+template <typename T>
+inline complex<T> operator*(const complex<T> &a, T s) {
+
+  return make_complex<T>(a.real*s, a.imag*s);
+}
+
+
+// Complex Conjugate a-bi = conj(a+bi)
+template <typename T>
+inline complex<T> conj(const complex<T> &c) {
+
+  return make_complex<T>(c.real, -c.imag);
+}
+
+
+// Squared Norm |c|^2 = re^2 + im^2
+template <typename T>
+inline T norm_sq(const complex<T> &c) {
+
+  return c.real*c.real + c.imag*c.imag;
+}
+
+
+// Complex Division c = a / b
+template <typename T>
+inline complex<T> operator/(const complex<T> &a, const complex<T> &b) {
+
+  complex<T> nu = a*conj(b);
+  T dn = norm_sq(b);
+
+  return make_complex<T>(nu.real/dn, nu.imag/dn);
+}
+
+
+// Compound assignment
+template <typename T>
+inline complex<T> &operator+=(complex<T> &a, const complex<T> &b) {
+
+  return a = a + b;
+}
+
+template <typename T>
+inline complex<T> &operator-=(complex<T> &a, const complex<T> &b) {
+
+  return a = a - b;
+}
+
+template <typename T>
+inline complex<T> &operator*=(complex<T> &a, const complex<T> &b) {
+
+  return a = a*b;
+}
+
+
+// Norm |c| in single precision (no promotion to double)
+inline float abs(const complex<float> &c) {
+
+  return sqrtf(norm_sq(c));
+}
+
+inline double abs(const complex<double> &c) {
+
+  return sqrt(norm_sq(c));
+}
+
+
+// Phase phi = phase(c) (radians)
+inline float arg(const complex<float> &c) {
+
+  return atan2f(c.imag, c.real);
+}
+
+inline double arg(const complex<double> &c) {
+
+  return atan2(c.imag, c.real);
+}
+
+
+// Complex Exponential z = exp(c) = exp(re)･(cos(im) + j･sin(im))
+inline complex<float> exp(const complex<float> &c) {
+
+  float r = expf(c.real);
+
+  return make_complex(r*cosf(c.imag), r*sinf(c.imag));
+}
+
+inline complex<double> exp(const complex<double> &c) {
+
+  double r = ::exp(c.real);
+
+  return make_complex(r*cos(c.imag), r*sin(c.imag));
+}
+
+
+// Q15 Multiplication c = a * b, rounded and saturated
+inline int16_t q15_sat(int32_t x) {
+
+  return (x > 32767)? 32767 : (x < -32768)? -32768 : (int16_t) x;
+}
+
+inline complex<int16_t> operator*(const complex<int16_t> &a,
+                                  const complex<int16_t> &b) {
+
+  int32_t re = (int32_t) a.real*b.real - (int32_t) a.imag*b.imag;
+  int32_t im = (int32_t) a.real*b.imag + (int32_t) a.imag*b.real;
+
+  return make_complex(q15_sat((re + (1 << 14)) >> 15),
+                      q15_sat((im + (1 << 14)) >> 15));
+}
+
+inline complex<int16_t> operator*(const complex<int16_t> &a, int16_t s) {
+
+  return make_complex(q15_sat(((int32_t) a.real*s + (1 << 14)) >> 15),
+                      q15_sat(((int32_t) a.imag*s + (1 << 14)) >> 15));
+}
+
+
+// Q15 Addition and Subtraction (wrap)
+inline complex<int16_t> operator+(const complex<int16_t> &a,
+                                  const complex<int16_t> &b) {
+
+  return make_complex((int16_t) (a.real + b.real), (int16_t) (a.imag + b.imag));
+}
+
+inline complex<int16_t> operator-(const complex<int16_t> &a,
+                                  const complex<int16_t> &b) {
+
+  return make_complex((int16_t) (a.real - b.real), (int16_t) (a.imag - b.imag));
+}
+
+inline complex<int16_t> operator-(const complex<int16_t> &a) {
+
+  return make_complex((int16_t) -a.real, (int16_t) -a.imag);
+}
+
+inline complex<int16_t> conj(const complex<int16_t> &c) {
+
+  return make_complex(c.real, (int16_t) -c.imag);
+}
+
+
+// Q15 Squared Norm |c|^2 (Q30)
+inline uint32_t norm_sq(const complex<int16_t> &c) {
+
+  return (uint32_t) ((int32_t) c.real*c.real) +
+         (uint32_t) ((int32_t) c.imag*c.imag);
+}
+
+
+// Q15 Norm |c| (approximate, max(a, 7/8･a + 1/2･b), a = max, b = min)
+inline uint32_t abs(const complex<int16_t> &c) {
+
+  uint32_t a = (c.real < 0)? -c.real : c.real;
+  uint32_t b = (c.imag < 0)? -c.imag : c.imag;
+
+  if (a < b) { // a = max, b = min
+    uint32_t t = a;
+    a = b;
+    b = t;
+  }
+
+  uint32_t m = a - (a >> 3) + (b >> 1);
+
+  return (m > a)? m : a;
+}
+
+} // namespace dsp
+
+#endif // __CPP98_COMPLEX_TEMPLATE_H_
@@ -8,7 +8,7 @@
  * Transform [2]. 
  *
  * Dependencies:
- *  "complex_numbers.h", ANSI C90
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
  *
  * References:
  *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
@@ -16,7 +16,7 @@
  *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
  *      3rd ed., Pearson Prentice Hall, 2010, pp. 652-654,750-751. 
  * 
- * Last modified on Sat 22 Nov 2014
+ * Last modified on Fri 16 Oct 2026
  *
  * Copyright by Petros Fountas. All rights reserved.
  */
@@ -31,12 +31,18 @@ void dft(
   int k,n;
   
   // 0 ≤ k ≤ N-1
-  for (k = 0; k < N; k++)
+  for (k = 0; k < N; k++) {
+    complex_t acc = {0, 0}; // accumulated in registers (inline operators)
+    int kn = 0; // k*n mod N, since W(N)^(k*n) is periodic in N
     // 0 ≤ n ≤ N-1
     for (n = 0; n < N; n++) {
       // y[k] = ∑ x[n]･W(N)^(k*n), W(N) = exp(-j･2𝜋/N) 
-      complex_t kn = complex_num(0, -2*M_PI*k*n/N);
-      y[k] = complex_add(y[k], complex_mul(x[n], complex_exp(kn)));
+      acc += x[n]*twiddle(N, kn);
+      kn += k;
+      if (kn >= N)
+        kn -= N;
     }
+    y[k] += acc;
+  }
   
 }
@@ -8,7 +8,7 @@
  * Transform [2]. 
  *
  * Dependencies:
- *  "complex_numbers.h", ANSI C90
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
  *
  * References:
  *  [1] ISO/IEC, "Programming Languages�C (ISO/IEC 9899:1990)," Geneva,
@@ -16,7 +16,7 @@
  *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
  *      3rd ed., Pearson Prentice Hall, 2010, pp. 652-654,750-751. 
  * 
- * Last modified on Sat 22 Nov 2014
+ * Last modified on Fri 16 Oct 2026
  *
  * Copyright by Petros Fountas. All rights reserved.
  */
@@ -25,6 +25,7 @@
 
 #include "mbed.h"
 #include "complex_numbers.h"
+#include "twiddle.h"
 
 
 // Discrete Fourier Transform (direct implementation)
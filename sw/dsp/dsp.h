@@ -15,6 +15,117 @@
  * | (dft.h)           |  out X:complex_t[N], is the DFT of the signal.
  * |                   |  in  x:complex_t[N], is a signal.
  * |                   |  
+ * | Twiddle factor    | w = twiddle(N,k),
+ * | (twiddle.h)       |  out w:complex_t, is W(N)^k = exp(-j･2𝜋k/N).
+ * |                   |  in  N:int, is the transform size.
+ * |                   |  in  k:int, is the exponent, 0 ≤ k ≤ N-1.
+ * |                   |
+ * | Window            | window_init(win,w,type,N,beta),
+ * | (window.h)        | win = window(type,N,beta),
+ * |                   |  out win:window_t*, is the window, its coefficients
+ * |                   |            win->w, coherent gain win->cg, power gain
+ * |                   |            win->U and ENBW win->enbw (bins).
+ * |                   |  out w:float[N], are the coefficients (init).
+ * |                   |  in  type:int, is WINDOW_HANN, WINDOW_HAMMING,
+ * |                   |            WINDOW_BLACKMAN_HARRIS, WINDOW_FLAT_TOP,
+ * |                   |            WINDOW_KAISER or WINDOW_RECTANGULAR.
+ * |                   |  in  N:int, is the window length.
+ * |                   |  in  beta:float, is the Kaiser shape parameter.
+ * |                   |
+ * | FFT               | fft(X,x,N),
+ * | (fft.h)           |  out X:complex_t[N], is the DFT of the signal.
+ * |                   |  in  x:complex_t[N], is a signal (may alias X).
+ * |                   |  in  N:int, is the size (power of two).
+ * |                   |  returns 0, or -1 if N is not a power of two.
+ * |                   |
+ * | Split-format FFT  | complex_soa_alloc(z,N), complex_soa_from(z,x,N),
+ * | (complex_soa.h)   | complex_soa_to(x,z,N), fft_soa(z,N), dft_soa(Z,z,N),
+ * |                   |  in  z:complex_soa_t*, is a split-format buffer, with
+ * |                   |            aligned z->real[N] and z->imag[N].
+ * |                   |  in  x:complex_t[N], is the same buffer as complex_t.
+ * |                   |  in  N:int, is the size (power of two for fft_soa).
+ * |                   |  out z:complex_soa_t*, is its DFT (fft_soa, in-place).
+ * |                   |  out Z:complex_soa_t*, is its DFT (dft_soa).
+ * |                   |
+ * | Real FFT          | rfft(X,x,N),
+ * | (fft.h)           |  out X:complex_t[N/2+1], are the unique DFT bins.
+ * |                   |  in  x:float[N], is a real signal.
+ * |                   |  in  N:int, is the size (power of two, N ≥ 2).
+ * |                   |  returns 0, or -1 if N is not a power of two.
+ * |                   |
+ * | Windowed real FFT | rfftw(X,x,w,N),
+ * | (fft.h)           |  out X:complex_t[N/2+1], are the unique DFT bins.
+ * |                   |  in  x:float[N], is a real signal.
+ * |                   |  in  w:float[N], is the window (NULL, rectangular).
+ * |                   |  in  N:int, is the size (power of two, N ≥ 2).
+ * |                   |  returns 0, or -1 if N is not a power of two.
+ * |                   |
+ * | Sliding DFT       | sdft_init(s,x,X,N,r), sdft_update(s,x),
+ * | (sdft.h)          |  in  s:sdft_t*, is the sliding DFT state.
+ * |                   |  in  x:float[N], is the window buffer (init).
+ * |                   |  out X:complex_t[N/2+1], are the DFT bins of the
+ * |                   |            last N samples, updated per sample.
+ * |                   |  in  N:int, is the DFT size.
+ * |                   |  in  r:float, is the damping factor, e.g. SDFT_R.
+ * |                   |  in  x:float, is a new sample (update).
+ * |                   |
+ * | Goertzel bank     | goertzel_init(b,g,K,N,Fs), i = goertzel_add(b,f),
+ * | (goertzel.h)      | goertzel_update(b,x), goertzel_magnitude(b,i),
+ * |                   | goertzel_psd(b,i),
+ * |                   |  in  b:goertzel_bank_t*, is the filter bank.
+ * |                   |  in  g:goertzel_t[K], are the filters (init).
+ * |                   |  in  N:int, is the block size (DFT size).
+ * |                   |  in  Fs:float, is the sampling frequency.
+ * |                   |  in  f:float, is a target frequency (add).
+ * |                   |  in  x:float, is a new sample (update), O(K).
+ * |                   |  out |X[k]| and 10･log10(|X[k]|^2) of filter i,
+ * |                   |            updated every N samples.
+ * |                   |
+ * | Welch PSD         | welch_init(e,work,L,ovl,w,Kmax), welch_push(e,x),
+ * | (welch.h)         | welch_psd(e,P),
+ * |                   |  in  e:welch_t*, is the Welch estimator.
+ * |                   |  in  work:float[WELCH_WORK_SIZE(L)], is its memory.
+ * |                   |  in  L:int, is the segment length (power of two).
+ * |                   |  in  ovl:int, is the overlap, e.g. WELCH_OVERLAP_50(L).
+ * |                   |  in  w:float[L], is the window (NULL, rectangular).
+ * |                   |  in  Kmax:int, are the segments averaged before
+ * |                   |            forgetting (0, no limit).
+ * |                   |  in  x:float, is a new sample (push).
+ * |                   |  out P:float[L/2+1], is the averaged periodogram.
+ * |                   |
+ * | Spectrum and PSD  | spectrum_psd(s,P,X,N,as,ps),
+ * | (spectrum.h)      | spectrum_psd_power(s,P,X2,N,as,ps),
+ * |                   |  out s:float[N], is the amplitude spectrum (or NULL).
+ * |                   |  out P:float[N], is the PSD in dB (or NULL).
+ * |                   |  in  X:complex_t[N/2+1], are the DFT bins.
+ * |                   |  in  X2:float[N/2+1], are the power bins |X|^2.
+ * |                   |  in  N:int, is the DFT size (N ≥ 4).
+ * |                   |  in  as:float, is the amplitude scale.
+ * |                   |  in  ps:float, is the density scale.
+ * |                   |
+ * | Spectral pipeline | pipeline_dft(s,X,x,win,N),
+ * | (pipeline.h)      | pipeline_dft_q15(s,P,Xq,e,x,win,N,Fs),
+ * |                   | pipeline_psd(P,X2,est,win,N,Fs),
+ * |                   |  out s:float[N], is the amplitude spectrum.
+ * |                   |  out P:float[N], is the PSD in dB.
+ * |                   |  out X:complex_t[N/2+1], are the DFT bins.
+ * |                   |  out Xq:complex_q15_t[N], are the Q15 DFT bins,
+ * |                   |            with the block exponent e:int*.
+ * |                   |  out X2:float[N/2+1], is the averaged periodogram.
+ * |                   |  in  x:float[N], is a block of a real signal.
+ * |                   |  in  win:window_t*, is the window of the block.
+ * |                   |  in  est:welch_t*, is the Welch estimator.
+ * |                   |  in  N:int, is the DFT size (power of two, N ≥ 4).
+ * |                   |  in  Fs:float, is the sampling frequency.
+ * |                   |
+ * | Q15 FFT           | fft_q15(x,N,e),
+ * | (fft.h)           |  in  x:complex_q15_t[N], is a Q15 signal.
+ * |                   |  out x:complex_q15_t[N], is its DFT (in-place).
+ * |                   |  in  N:int, is the size (power of two).
+ * |                   |  in  e:int*, is the block exponent, updated by the
+ * |                   |            scaling shifts of the transform.
+ * |                   |  returns 0, or -1 if N is not a power of two.
+ * |                   |
  *
  * The following utilities are included:
  * 
@@ -36,15 +147,44 @@
  * |                   |                  expressed as fractions of PI.
  * |                   |  in  M:int, is the number of components.
  * |                   |
+ * | Arena             | arena_init(a,m,size), p = arena_alloc(a,n),
+ * | (arena.h)         | arena_reset(a),
+ * |                   |  in  a:arena_t*, is the arena.
+ * |                   |  in  m:void*, is its memory block (init).
+ * |                   |  in  size:size_t, is the size of the block (bytes).
+ * |                   |  in  n:size_t, is the size of a buffer (bytes).
+ * |                   |  returns p:void*, aligned to ARENA_ALIGN, or NULL if
+ * |                   |            the arena is full.
+ * |                   |
+ * | SPSC ring buffer  | dsp::ring_buffer<T,N> r, r.push(x), r.pop(&x),
+ * | (ring_buffer.h)   | p = r.reserve(&n), r.commit(n),
+ * |                   | p = r.peek(&n), r.consume(n),
+ * |                   |  in  T:type, is the element type.
+ * |                   |  in  N:uint32_t, is the capacity (power of two).
+ * |                   |  in  x:T, is an element (push), or out x:T* (pop).
+ * |                   |  out p:T*, is the contiguous run of n free (reserve)
+ * |                   |            or available (peek) elements.
+ * |                   |  returns true, or false if full (push) or empty (pop).
+ * |                   |
+ * | Snapshot          | dsp::snapshot<T> s, s.back(), seq = s.publish(),
+ * | (snapshot.h)      | seq = s.sequence(), s.front(seq), s.valid(seq),
+ * |                   | seq = s.read(&copy),
+ * |                   |  in  T:type, is the result type.
+ * |                   |  out s.back():T&, is the result being written.
+ * |                   |  in  s.front(seq):T&, is the result of seq, which is
+ * |                   |            valid if s.valid(seq) after the reads.
+ * |                   |  returns seq:uint32_t, the number of the result.
+ * |                   |
  * 
  * Dependencies:
- *  "complex_numbers.h", ANSI C90
+ *  "complex_template.h", "complex_numbers.h", "fixed_point.h",
+ *  "ring_buffer.h", "snapshot.h", ANSI C90
  *
  * References:
  *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
  *      Switzerland: ISO, 1990.
  * 
- * Last modified on Sat 22 Nov 2014
+ * Last modified on Fri 16 Oct 2026
  *
  * Copyright by Petros Fountas. All rights reserved.
  */
@@ -52,9 +192,22 @@
 #define __C90_DSP_H_
 
 #include "complex_numbers.h"
+#include "fixed_point.h"
+#include "twiddle.h"
+#include "window.h"
 #include "dft.h"
+#include "fft.h"
+#include "complex_soa.h"
+#include "sdft.h"
+#include "goertzel.h"
+#include "welch.h"
+#include "spectrum.h"
+#include "pipeline.h"
 #include "sin_wave.h"
 #include "chplot.h"
+#include "arena.h"
+#include "ring_buffer.h"
+#include "snapshot.h"
 
 
 #endif // __C90_DSP_H_
@@ -0,0 +1,220 @@
+/* fft.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the radix-2
+ * decimation-in-time Fast Fourier Transform [2].
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 723-737.
+ *  [3] Brigham, E. O., "The Fast Fourier Transform and its Applications,"
+ *      Prentice-Hall, 1988, pp. 166-169.
+ *  [4] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 759-762.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "fft.h"
+
+// Power of two test
+int is_pow2(int N) {
+
+  return (N > 0) && ((N & (N - 1)) == 0);
+}
+
+
+// Fast Fourier Transform (iterative radix-2 decimation-in-time)
+int fft(
+  complex_t *X, // FFT output of the signal.
+  complex_t *x, // input signal.
+  int N) {      // FFT size (number of samples, power of two).
+
+  int i,j,k,m;
+
+  if (!is_pow2(N))
+    return -1;
+
+  // copy the input, unless the transform is computed in-place
+  if (X != x)
+    for (i = 0; i < N; i++)
+      X[i] = x[i];
+
+  // bit-reversed reordering, X[i] <-> X[rev(i)]
+  for (i = 1, j = 0; i < N; i++) {
+    int bit = N >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      complex_t t = X[i];
+      X[i] = X[j];
+      X[j] = t;
+    }
+  }
+
+  // log2(N) butterfly stages, m = 2, 4, ..., N
+  for (m = 2; m <= N; m <<= 1) {
+    int half = m >> 1;
+    int stride = N / m; // W(m)^j = W(N)^(j*N/m)
+
+    // 0 ≤ j ≤ m/2-1, W(m)^j
+    for (j = 0; j < half; j++) {
+      complex_t w = twiddle(N, j*stride);
+      // butterflies of every group that share W(m)^j
+      for (k = j; k < N; k += m) {
+        complex_t t = complex_mul(w, X[k + half]);
+        X[k + half] = complex_sub(X[k], t);
+        X[k] = complex_add(X[k], t);
+      }
+    }
+  }
+
+  return 0;
+}
+
+
+// Real-input Fast Fourier Transform
+int rfft(
+  complex_t *X, // FFT output of the signal, N/2+1 bins.
+  float *x,     // input signal.
+  int N) {      // FFT size (number of samples, power of two).
+
+  return rfftw(X, x, NULL, N);
+}
+
+
+// Windowed real-input Fast Fourier Transform
+int rfftw(
+  complex_t *X,   // FFT output of the windowed signal, N/2+1 bins.
+  float *x,       // input signal.
+  const float *w, // window, float[N], or NULL for rectangular.
+  int N) {        // FFT size (number of samples, power of two).
+
+  int n,k;
+  int M = N >> 1; // size of the packed complex transform
+
+  if (!is_pow2(N) || N < 2)
+    return -1;
+
+  // pack even/odd windowed samples as z[n] = x[2n]･w[2n] + j･x[2n+1]･w[2n+1],
+  // 0 ≤ n ≤ M-1 (the window is applied by the packing loop)
+  if (w != NULL) {
+    for (n = 0; n < M; n++)
+      X[n] = complex_num(x[2*n]*w[2*n], x[2*n + 1]*w[2*n + 1]);
+  } else {
+    for (n = 0; n < M; n++)
+      X[n] = complex_num(x[2*n], x[2*n + 1]);
+  }
+
+  // Z = FFT(z), in-place
+  fft(X, X, M);
+
+  // DC and Nyquist bins are real
+  complex_t z0 = X[0];
+  X[0] = complex_num(z0.real + z0.imag, 0);
+  X[M] = complex_num(z0.real - z0.imag, 0);
+
+  // post-twiddle, bins k and M-k are computed together, 1 ≤ k ≤ M/2
+  for (k = 1; k <= M/2; k++) {
+    complex_t a = X[k];
+    complex_t b = complex_conj(X[M - k]);
+    // even part Ze[k] = (Z[k] + conj(Z[M-k]))/2
+    complex_t ze = complex_num((a.real + b.real)/2, (a.imag + b.imag)/2);
+    // odd part Zo[k] = -j･(Z[k] - conj(Z[M-k]))/2
+    complex_t zo = complex_num((a.imag - b.imag)/2, (b.real - a.real)/2);
+
+    // X[k] = Ze[k] + W(N)^k･Zo[k]
+    // X[M-k] = conj(Ze[k]) + W(N)^(M-k)･conj(Zo[k])
+    X[k] = complex_add(ze, complex_mul(twiddle(N, k), zo));
+    X[M - k] = complex_add(complex_conj(ze),
+                           complex_mul(twiddle(N, M - k), complex_conj(zo)));
+  }
+
+  return 0;
+}
+
+
+// Block floating point headroom, |x| < 1/4 guarantees that a radix-2
+// butterfly (gain ≤ 1+√2 per component) cannot overflow
+#define Q15_HEADROOM 0x2000
+
+// Fast Fourier Transform in Q15 with block floating point (in-place)
+int fft_q15(
+  complex_q15_t *x, // input signal, FFT output on return.
+  int N,            // FFT size (number of samples, power of two).
+  int *e) {         // block exponent, updated.
+
+  int i,j,k,m;
+
+  if (!is_pow2(N))
+    return -1;
+
+  // bit-reversed reordering, x[i] <-> x[rev(i)]
+  for (i = 1, j = 0; i < N; i++) {
+    int bit = N >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      complex_q15_t t = x[i];
+      x[i] = x[j];
+      x[j] = t;
+    }
+  }
+
+  // log2(N) butterfly stages, m = 2, 4, ..., N
+  for (m = 2; m <= N; m <<= 1) {
+    int half = m >> 1;
+    int stride = N / m;
+
+    // scale the block until it has enough headroom for this stage
+    int32_t xmax = 0;
+    for (i = 0; i < N; i++) {
+      int32_t a = (x[i].real < 0)? -x[i].real : x[i].real;
+      int32_t b = (x[i].imag < 0)? -x[i].imag : x[i].imag;
+      xmax |= a | b; // only the most significant bit matters
+    }
+    int shift = 0;
+    for (; xmax >= Q15_HEADROOM; xmax >>= 1)
+      shift++;
+    if (shift) {
+      int32_t round = 1 << (shift - 1);
+      for (i = 0; i < N; i++) {
+        x[i].real = (q15_t) ((x[i].real + round) >> shift);
+        x[i].imag = (q15_t) ((x[i].imag + round) >> shift);
+      }
+      *e += shift;
+    }
+
+    // 0 ≤ j ≤ m/2-1, W(m)^j
+    for (j = 0; j < half; j++) {
+      complex_q15_t w = twiddle_q15(N, j*stride);
+      // butterflies of every group that share W(m)^j
+      for (k = j; k < N; k += m) {
+        complex_q15_t a = x[k];
+        complex_q15_t b = x[k + half];
+        // t = W･b, Q30 products rounded to Q15
+        int32_t tr = ((int32_t) w.real*b.real - (int32_t) w.imag*b.imag +
+                      (1 << 14)) >> 15;
+        int32_t ti = ((int32_t) w.real*b.imag + (int32_t) w.imag*b.real +
+                      (1 << 14)) >> 15;
+        x[k + half].real = (q15_t) (a.real - tr);
+        x[k + half].imag = (q15_t) (a.imag - ti);
+        x[k].real = (q15_t) (a.real + tr);
+        x[k].imag = (q15_t) (a.imag + ti);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/* fft.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the radix-2 decimation-in-time
+ * Fast Fourier Transform [2].
+ *
+ * The transform computes the same sequence as dft(), but in O(N･log2(N))
+ * operations instead of O(N^2). The size of the transform must be a power
+ * of two.
+ *
+ * A real-input variant, which returns only the N/2+1 unique bins of a real
+ * signal at roughly half the cost, is also provided. It may apply a window
+ * (see window.h) to the signal while it is packed.
+ *
+ * A Q15 variant uses integer arithmetic only. Overflow is avoided with block
+ * floating point [4]: the block is scaled down by powers of two before any
+ * stage that could overflow, and the shifts are added to the block exponent.
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 723-737.
+ *  [3] Brigham, E. O., "The Fast Fourier Transform and its Applications,"
+ *      Prentice-Hall, 1988, pp. 166-169.
+ *  [4] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 759-762.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_FFT_H_
+#define __C90_FFT_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "fixed_point.h"
+#include "twiddle.h"
+
+
+// Power of two test, returns 1 if N = 2^m (m ≥ 0), 0 otherwise
+int is_pow2(int N);
+
+
+// Fast Fourier Transform (iterative radix-2 decimation-in-time)
+//
+// X may be the same buffer as x, in which case the transform is computed
+// in-place. Returns 0 on success, -1 if N is not a power of two.
+int fft(
+  complex_t *X, // FFT output of the signal.
+  complex_t *x, // input signal.
+  int N);       // FFT size (number of samples, power of two).
+
+
+// Real-input Fast Fourier Transform
+//
+// The N real samples are packed as N/2 complex samples, transformed with
+// fft() and separated with a post-twiddle stage [3]. Only the N/2+1 unique
+// bins X[0..N/2] are returned, since X[N-k] = conj(X[k]) for real signals.
+// Returns 0 on success, -1 if N is not a power of two or N < 2.
+int rfft(
+  complex_t *X, // FFT output of the signal, N/2+1 bins.
+  float *x,     // input signal.
+  int N);       // FFT size (number of samples, power of two).
+
+
+// Windowed real-input Fast Fourier Transform
+//
+// Same as rfft() of the signal x[n]･w[n], the window is applied while the
+// samples are packed, so the signal is read only once.
+// Returns 0 on success, -1 if N is not a power of two or N < 2.
+int rfftw(
+  complex_t *X,   // FFT output of the windowed signal, N/2+1 bins.
+  float *x,       // input signal.
+  const float *w, // window, float[N], or NULL for rectangular.
+  int N);         // FFT size (number of samples, power of two).
+
+
+// Fast Fourier Transform in Q15 with block floating point (in-place)
+//
+// The value of X[k] is X[k]･2^e on return, where e is the block exponent of
+// x on entry plus the scaling shifts of the transform.
+// Returns 0 on success, -1 if N is not a power of two.
+int fft_q15(
+  complex_q15_t *x, // input signal, FFT output on return.
+  int N,            // FFT size (number of samples, power of two).
+  int *e);          // block exponent, updated.
+
+
+#endif // __C90_FFT_H_
@@ -0,0 +1,96 @@
+/* fixed_point.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the integer operations
+ * used by the fixed-point spectral pipeline.
+ *
+ * Dependencies:
+ *  "stdint.h", ANSI C99
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 759-762.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "fixed_point.h"
+
+// log2(1 + i/32) in Q8, 0 ≤ i ≤ 32
+static const uint16_t log2_lut[33] = {
+    0,  11,  22,  33,  44,  54,  63,  73,  82,  92, 100, 109, 118, 126,
+  134, 142, 150, 157, 165, 172, 179, 186, 193, 200, 207, 213, 220, 226,
+  232, 238, 244, 250, 256
+};
+
+// 10･log10(2) in Q8
+#define DB_PER_OCTAVE_Q8 771
+
+
+// Block conversion y[n] = (x[n] - d)･w[n]/2^e + 0i
+int q15_from_float(
+  complex_q15_t *y, // output Q15 block.
+  const float *x,   // input signal.
+  const float *w,   // window, float[N], or NULL for rectangular.
+  int N,            // number of samples.
+  int dc) {         // remove mean.
+
+  int n,e;
+
+  // d = mean(x)
+  float d = 0;
+  if (dc) {
+    for (n = 0; n < N; n++)
+      d += x[n];
+    d /= N;
+  }
+
+  // find max|(x-d)･w|
+  float xmax = 0;
+  for (n = 0; n < N; n++) {
+    float a = (x[n] < d)? d - x[n] : x[n] - d;
+    if (w != NULL)
+      a *= (w[n] < 0)? -w[n] : w[n];
+    xmax = (a > xmax)? a : xmax;
+  }
+
+  // xmax = m･2^e, 0.5 ≤ m < 1, so that |x[n]-d|/2^e < 1
+  frexp(xmax, &e);
+  float scale = ldexp(1.0, 15 - e);
+
+  for (n = 0; n < N; n++) {
+    float q = (x[n] - d)*((w != NULL)? w[n]*scale : scale);
+    y[n].real = (q >= Q15_ONE)? Q15_ONE : (q15_t) q;
+    y[n].imag = 0;
+  }
+
+  return e - 15; // value = q･2^(e-15)
+}
+
+
+// Decibels 10･log10(p･2^e) in Q8
+int32_t q15_db(
+  uint32_t p, // power.
+  int e) {    // binary exponent of p.
+
+  if (p == 0)
+    return Q15_DB_MIN;
+
+  // p = 2^msb･(1 + f), 0 ≤ f < 1
+  int msb = 31 - __builtin_clz(p);
+  uint32_t f = (msb >= 13)? (p >> (msb - 13)) : (p << (13 - msb));
+  int i = (f >> 8) & 0x1F; // 5 most significant bits of f
+  int r = f & 0xFF;        // next 8 bits, for linear interpolation
+
+  // log2(p) in Q8
+  int32_t l = (int32_t) msb*256 + log2_lut[i] +
+              (((log2_lut[i + 1] - log2_lut[i])*r) >> 8);
+
+  return ((l + (int32_t) e*256)*DB_PER_OCTAVE_Q8) >> 8;
+}
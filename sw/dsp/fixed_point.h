@@ -0,0 +1,111 @@
+/* fixed_point.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the Q15 fixed-point complex
+ * number and the declarations of the integer operations used by the
+ * fixed-point spectral pipeline. The Cortex-M3 has no FPU, so these avoid
+ * the soft-float library calls of the float pipeline.
+ *
+ * A Q15 number q represents q/2^15 in [-1, 1). Blocks of Q15 numbers share
+ * a common exponent e (block floating point [2]), so that every element of
+ * the block represents the value q･2^e.
+ *
+ * Complex Q15 type is defined as structure
+ *
+ *      { real: q15_t, imag: q15_t }
+ *
+ * and is associated with the user defined type:
+ *
+ *                complex_q15_t
+ *
+ * The following operations are supported:
+ *
+ *  Supported Operations    | Usage                          | Output   | Input
+ *  -----------------------------------------------------------------------------
+ *  Block conversion        | e = q15_from_float(y,x,w,N,dc) | int      | float[N]
+ *  Magnitude (approximate) | m = complex_q15_mag(c)         | uint32_t | complex_q15_t
+ *  Power (Q30)             | p = complex_q15_power(c)       | uint32_t | complex_q15_t
+ *  Decibels (Q8)           | d = q15_db(p,e)                | int32_t  | uint32_t,int
+ *
+ * Dependencies:
+ *  "complex_template.h", "stdint.h", ANSI C99
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 759-762.
+ *  [3] Lyons, R. G., "Understanding Digital Signal Processing," 3rd ed.,
+ *      Prentice Hall, 2011, pp. 756-762.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_FIXED_POINT_H_
+#define __C90_FIXED_POINT_H_
+
+#include "mbed.h"
+#include <stdint.h>
+#include "complex_template.h"
+
+// Q15 one (largest positive Q15 value)
+#define Q15_ONE 32767
+
+// Decibel value returned by q15_db() for zero power (-128 dB in Q8)
+#define Q15_DB_MIN (-128*256)
+
+// Q15 number
+typedef int16_t q15_t;
+
+/* Complex Q15 Type
+ *
+ * References:
+ *  [1]  Weisstein, Eric W. "Complex Number." From MathWorld--A Wolfram Web
+ *       Resource. http://mathworld.wolfram.com/ComplexNumber.html
+ */
+typedef dsp::complex<q15_t> complex_q15_t;
+
+
+// Block conversion y[n] = (x[n] - d)･w[n]/2^e + 0i, returns the block
+// exponent e, chosen so that the largest |y[n]| uses the full Q15 range. If
+// dc is non-zero, d is the mean of x (which zeroes the DC bin but keeps the
+// small AC components of a large offset signal in range), otherwise d = 0.
+// The window w (see window.h) is applied by the conversion loop.
+int q15_from_float(
+  complex_q15_t *y, // output Q15 block.
+  const float *x,   // input signal.
+  const float *w,   // window, float[N], or NULL for rectangular.
+  int N,            // number of samples.
+  int dc);          // remove mean.
+
+
+// Magnitude |c| (approximate, max(a, 7/8･a + 1/2･b), a = max, b = min)
+//
+// References:
+//  [1]  Lyons, R. G., "Understanding Digital Signal Processing," 3rd ed.,
+//       Prentice Hall, 2011, pp. 756-762.
+inline uint32_t complex_q15_mag(complex_q15_t c) {
+
+  return dsp::abs(c);
+}
+
+
+// Power |c|^2 = re^2 + im^2 (Q30)
+inline uint32_t complex_q15_power(complex_q15_t c) {
+
+  return dsp::norm_sq(c);
+}
+
+
+// Decibels 10･log10(p･2^e) in Q8 (1/256 dB), using a log2 lookup table,
+// returns Q15_DB_MIN if p is 0
+int32_t q15_db(
+  uint32_t p, // power.
+  int e);     // binary exponent of p.
+
+
+#endif // __C90_FIXED_POINT_H_
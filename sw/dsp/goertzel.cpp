@@ -0,0 +1,113 @@
+/* goertzel.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of a bank of Goertzel
+ * filters [2].
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 717-719.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "goertzel.h"
+
+// Goertzel bank initialisation
+void goertzel_init(
+  goertzel_bank_t *b, // Goertzel bank.
+  goertzel_t *g,      // filters buffer, goertzel_t[capacity].
+  int capacity,       // maximum number of filters.
+  int N,              // block size (DFT size).
+  float Fs) {         // sampling frequency (Hz).
+
+  b->N = N;
+  b->Fs = Fs;
+  b->n = 0;
+  b->K = 0;
+  b->capacity = capacity;
+  b->g = g;
+}
+
+
+// Register a target frequency
+int goertzel_add(
+  goertzel_bank_t *b, // Goertzel bank.
+  float f) {          // target frequency (Hz).
+
+  if (b->K == b->capacity || f < 0 || f > b->Fs/2)
+    return -1;
+
+  goertzel_t *g = &b->g[b->K];
+
+  g->f = f;
+  g->k = (int) floor(f*b->N/b->Fs + 0.5);
+  g->coeff = 2*complex_real(twiddle(b->N, g->k));
+  g->s1 = g->s2 = 0;
+  g->power = 0;
+
+  return b->K++;
+}
+
+
+// Update all filters with a new sample
+int goertzel_update(
+  goertzel_bank_t *b, // Goertzel bank.
+  float x) {          // new sample.
+
+  int i;
+
+  // s(n) = x(n) + 2･cos(2𝜋k/N)･s(n-1) - s(n-2), 0 ≤ i ≤ K-1
+  for (i = 0; i < b->K; i++) {
+    goertzel_t *g = &b->g[i];
+    float s = x + g->coeff*g->s1 - g->s2;
+    g->s2 = g->s1;
+    g->s1 = s;
+  }
+
+  if (++b->n < b->N)
+    return 0;
+
+  // end of block, |X[k]|^2 = s1^2 + s2^2 - 2･cos(2𝜋k/N)･s1･s2
+  for (i = 0; i < b->K; i++) {
+    goertzel_t *g = &b->g[i];
+    g->power = g->s1*g->s1 + g->s2*g->s2 - g->coeff*g->s1*g->s2;
+    g->s1 = g->s2 = 0;
+  }
+  b->n = 0;
+
+  return 1;
+}
+
+
+// Magnitude 2/N･|X[k]| of filter i
+float goertzel_magnitude(
+  goertzel_bank_t *b, // Goertzel bank.
+  int i) {            // filter index.
+
+  float p = b->g[i].power;
+
+  // rounding may leave p slightly negative
+  return (p > 0)? 2*sqrtf(p)/b->N : 0;
+}
+
+
+// Power 10･log10(2/(Fs･N)･|X[k]|^2) of filter i
+float goertzel_psd(
+  goertzel_bank_t *b, // Goertzel bank.
+  int i) {            // filter index.
+
+  float p = b->g[i].power*2/(b->Fs*b->N);
+
+  // rounding may leave p zero or slightly negative
+  return (p > 0)? 10*log10f(p) : GOERTZEL_DB_MIN;
+}
@@ -0,0 +1,106 @@
+/* goertzel.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of a bank of Goertzel filters [2],
+ * which monitors a small set of K target frequencies of a signal.
+ *
+ * Every filter computes one DFT bin X[k] of consecutive blocks of N samples,
+ * with k = round(f･N/Fs) the bin closest to its target frequency f. A sample
+ * costs O(K) operations, compared to O(N･log2(N)) per block for the FFT, so
+ * the bank is cheaper than the full transform when K is small.
+ *
+ * The outputs are in the same units as the full transform pipeline of an
+ * unwindowed block (spectrum_psd() with the scales of a rectangular window):
+ * amplitude 2/N･|X[k]| as spectrum[] and density 10･log10(2/(Fs･N)･|X[k]|^2)
+ * as Pxx[].
+ *
+ * Goertzel bank is defined as structure and is associated with the user
+ * defined type:
+ *
+ *                goertzel_bank_t
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 717-719.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_GOERTZEL_H_
+#define __C90_GOERTZEL_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "twiddle.h"
+
+// Density returned by goertzel_psd() for zero power (dB), as Q15_DB_MIN
+#define GOERTZEL_DB_MIN (-128.0f)
+
+// Goertzel filter
+typedef struct {
+  float f;      // target frequency (Hz).
+  int k;        // DFT bin, k = round(f･N/Fs).
+  float coeff;  // 2･cos(2𝜋k/N).
+  float s1, s2; // filter state, s(n-1) and s(n-2).
+  float power;  // |X[k]|^2 of the last complete block.
+} goertzel_t;
+
+// Goertzel filter bank
+typedef struct {
+  int N;          // block size (DFT size).
+  float Fs;       // sampling frequency (Hz).
+  int n;          // samples of the current block.
+  int K;          // number of registered filters.
+  int capacity;   // maximum number of filters.
+  goertzel_t *g;  // filters, goertzel_t[capacity].
+} goertzel_bank_t;
+
+
+// Goertzel bank initialisation, with no registered frequencies
+void goertzel_init(
+  goertzel_bank_t *b, // Goertzel bank.
+  goertzel_t *g,      // filters buffer, goertzel_t[capacity].
+  int capacity,       // maximum number of filters.
+  int N,              // block size (DFT size).
+  float Fs);          // sampling frequency (Hz).
+
+
+// Register a target frequency, 0 ≤ f ≤ Fs/2
+// Returns the index of its filter, or -1 if the bank is full or f is out of
+// range.
+int goertzel_add(
+  goertzel_bank_t *b, // Goertzel bank.
+  float f);           // target frequency (Hz).
+
+
+// Update all filters with a new sample, O(K)
+// Returns 1 when the sample completes a block and the outputs are updated,
+// 0 otherwise.
+int goertzel_update(
+  goertzel_bank_t *b, // Goertzel bank.
+  float x);           // new sample.
+
+
+// Amplitude 2/N･|X[k]| of filter i, in the units of spectrum[]
+float goertzel_magnitude(
+  goertzel_bank_t *b, // Goertzel bank.
+  int i);             // filter index.
+
+
+// Density 10･log10(2/(Fs･N)･|X[k]|^2) of filter i, in the units of Pxx[],
+// GOERTZEL_DB_MIN if the power is 0
+float goertzel_psd(
+  goertzel_bank_t *b, // Goertzel bank.
+  int i);             // filter index.
+
+
+#endif // __C90_GOERTZEL_H_
@@ -0,0 +1,94 @@
+/* pipeline.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the spectral pipeline of
+ * the application.
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", "window.h", "fft.h", "welch.h",
+ *  "spectrum.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "pipeline.h"
+
+// Amplitude spectrum of the windowed block x
+int pipeline_dft(
+  float *spectrum,       // output spectrum, float[N].
+  complex_t *X,          // output DFT bins, N/2+1.
+  float *x,              // block, float[N].
+  const window_t *win,   // window of the block (length N).
+  int N) {               // DFT size (power of two, N ≥ 4).
+
+  // N is a power of two and x is real, so the real FFT applies
+  if (rfftw(X, x, win->w, N) != 0)
+    return -1;
+
+  spectrum_psd(spectrum, NULL, X, N, 2.0f/(N*win->cg), 0);
+  return 0;
+}
+
+
+// Amplitude spectrum and PSD (dB) of the windowed block x in Q15
+int pipeline_dft_q15(
+  float *spectrum,       // output spectrum, float[N].
+  float *Pxx,            // output PSD, float[N].
+  complex_q15_t *X,      // output DFT bins, complex_q15_t[N].
+  int *e,                // output block exponent of the bins.
+  const float *x,        // block, float[N].
+  const window_t *win,   // window of the block (length N).
+  int N,                 // DFT size (power of two, N ≥ 4).
+  float Fs) {            // sampling frequency.
+
+  int n;
+  float as, db;
+  uint32_t m1;
+
+  // without the DC offset of the block (bin 0 is not displayed)
+  *e = q15_from_float(X, x, win->w, N, 1);
+  if (fft_q15(X, N, e) != 0)
+    return -1;
+
+  // amplitude scale of the bins X[k]･2^e, density scale in dB
+  as = ldexpf(2.0f/(N*win->cg), *e);
+  db = 10*log10f(2.0f/(Fs*N*win->U));
+
+  // the points of spectrum_psd(), the magnitude and the power of every bin
+  // are computed once, 10･log10(|X|^2) in Q8 dB
+  m1 = complex_q15_mag(X[1]);
+  for (n = 0; n < N/2 - 1; n++) {
+    uint32_t m2 = complex_q15_mag(X[n + 2]);
+    uint32_t avg = (m1 + m2) >> 1;
+    spectrum[2*n] = m1*as;
+    spectrum[2*n + 1] = avg*as;
+    Pxx[2*n] = q15_db(complex_q15_power(X[n + 1]), 2*(*e))/256.0f + db;
+    Pxx[2*n + 1] = q15_db(avg*avg, 2*(*e))/256.0f + db;
+    m1 = m2;
+  }
+  spectrum[N - 2] = spectrum[N - 1] = 0;
+  Pxx[N - 2] = Pxx[N - 1] = 0;
+  return 0;
+}
+
+
+// PSD (dB) of the averaged periodogram of a Welch estimator
+void pipeline_psd(
+  float *Pxx,            // output PSD, float[N].
+  float *P,              // output averaged periodogram, float[N/2+1].
+  welch_t *e,            // Welch estimator (segments of N samples).
+  const window_t *win,   // window of the segments (length N).
+  int N,                 // segment length (N ≥ 4).
+  float Fs) {            // sampling frequency.
+
+  welch_psd(e, P);
+  spectrum_psd_power(NULL, Pxx, P, N, 0, 2.0f/(Fs*N*win->U));
+}
@@ -0,0 +1,85 @@
+/* pipeline.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the spectral pipeline of the
+ * application, which turns a block of N real samples into the amplitude
+ * spectrum and the Power Spectral Density (PSD) it displays. The firmware
+ * and the host benchmarks call the same stages, so that the benchmarks time
+ * what the firmware runs.
+ *
+ *  Stage                  | Steps
+ *  ---------------------------------------------------------------------------
+ *  pipeline_dft()         | rfftw() of the windowed block, spectrum_psd()
+ *                         | with the amplitude scale 2/(N･cg).
+ *  pipeline_dft_q15()     | q15_from_float() of the windowed block without
+ *                         | its DC offset, fft_q15(), the spectrum and the
+ *                         | periodogram of the block (Q15 build, which has
+ *                         | no Welch averaging).
+ *  pipeline_psd()         | welch_psd() of the averaged periodogram,
+ *                         | spectrum_psd_power() with the density scale
+ *                         | 2/(Fs･N･U).
+ *
+ * The gains cg and U are those of the window (see window.h).
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", "window.h", "fft.h", "welch.h",
+ *  "spectrum.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_PIPELINE_H_
+#define __C90_PIPELINE_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "fixed_point.h"
+#include "window.h"
+#include "fft.h"
+#include "welch.h"
+#include "spectrum.h"
+
+
+// Amplitude spectrum of the windowed block x
+// Returns 0, or -1 if N is not a power of two.
+int pipeline_dft(
+  float *spectrum,       // output spectrum, float[N].
+  complex_t *X,          // output DFT bins, N/2+1.
+  float *x,              // block, float[N].
+  const window_t *win,   // window of the block (length N).
+  int N);                // DFT size (power of two, N ≥ 4).
+
+
+// Amplitude spectrum and PSD (dB) of the windowed block x in Q15, the bins
+// are X[k]･2^e
+// Returns 0, or -1 if N is not a power of two.
+int pipeline_dft_q15(
+  float *spectrum,       // output spectrum, float[N].
+  float *Pxx,            // output PSD, float[N].
+  complex_q15_t *X,      // output DFT bins, complex_q15_t[N].
+  int *e,                // output block exponent of the bins.
+  const float *x,        // block, float[N].
+  const window_t *win,   // window of the block (length N).
+  int N,                 // DFT size (power of two, N ≥ 4).
+  float Fs);             // sampling frequency.
+
+
+// PSD (dB) of the averaged periodogram of a Welch estimator
+void pipeline_psd(
+  float *Pxx,            // output PSD, float[N].
+  float *P,              // output averaged periodogram, float[N/2+1].
+  welch_t *e,            // Welch estimator (segments of N samples).
+  const window_t *win,   // window of the segments (length N).
+  int N,                 // segment length (N ≥ 4).
+  float Fs);             // sampling frequency.
+
+
+#endif // __C90_PIPELINE_H_
@@ -0,0 +1,147 @@
+/* ring_buffer.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of a wait-free single-producer,
+ * single-consumer ring buffer of a fixed capacity, which passes samples from
+ * an interrupt handler (e.g. a Ticker) to a thread, or between two threads,
+ * without locks and without allocations.
+ *
+ * The ring buffer is associated with the user defined type:
+ *
+ *            dsp::ring_buffer<T, N>, N is a power of two
+ *
+ * The producer and the consumer own one index each, which run freely modulo
+ * 2^32 and are published with release stores and read with acquire loads,
+ * so that the elements written before a push() are visible after the
+ * matching pop(). The indices are on separate cache lines (words on the
+ * Cortex-M3, which has no data cache), so that the producer and the consumer
+ * do not share lines on a multi-core host.
+ *
+ * The following operations are supported:
+ *
+ *  Operations             | Usage                  | Caller
+ *  ---------------------------------------------------------------------------
+ *  Push an element        | ok = r.push(x)         | producer
+ *  Pop an element         | ok = r.pop(&x)         | consumer
+ *  Reserve, commit        | p = r.reserve(&n),     | producer
+ *                         | r.commit(n)            |
+ *  Peek, consume          | p = r.peek(&n),        | consumer
+ *                         | r.consume(n)           |
+ *  Elements, free space   | r.size(), r.space()    | either (snapshot)
+ *
+ * reserve() and peek() return the contiguous run of free and of available
+ * elements in the storage, so that blocks of samples can be written and read
+ * in place (a second call returns the rest, after the wrap).
+ *
+ * Dependencies:
+ *  "stdint.h", GCC __atomic built-ins
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] Lamport, L., "Specifying Concurrent Program Modules," ACM Trans.
+ *      Program. Lang. Syst., vol. 5, no. 2, pp. 190-222, 1983.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_RING_BUFFER_H_
+#define __CPP98_RING_BUFFER_H_
+
+#include <stdint.h>
+
+// Alignment of the indices
+#ifdef TARGET_CORTEX_M
+#define RING_BUFFER_ALIGN 4
+#else
+#define RING_BUFFER_ALIGN 64 // cache line
+#endif
+
+namespace dsp {
+
+template <typename T, uint32_t N>
+class ring_buffer {
+public:
+
+  ring_buffer() : head(0), tail(0) {
+    typedef char capacity_is_a_power_of_two[(N >= 2 && !(N & (N - 1)))? 1:-1]
+      __attribute__((unused));
+  }
+
+  uint32_t capacity() const { return N; }
+
+  // Elements available to the consumer
+  uint32_t size() const {
+    return __atomic_load_n(&head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+  }
+
+  // Free elements available to the producer
+  uint32_t space() const { return N - size(); }
+
+  // Push x, returns false if the buffer is full
+  bool push(const T &x) {
+    uint32_t h = head; // owned by the producer
+    if (h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == N)
+      return false;
+    buffer[h & (N - 1)] = x;
+    __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // Pop into x, returns false if the buffer is empty
+  bool pop(T *x) {
+    uint32_t t = tail; // owned by the consumer
+    if (__atomic_load_n(&head, __ATOMIC_ACQUIRE) == t)
+      return false;
+    *x = buffer[t & (N - 1)];
+    __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // Contiguous free elements to write in place, n is set to their number
+  T *reserve(uint32_t *n) {
+    uint32_t h = head;
+    uint32_t free = N - (h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE));
+    uint32_t run = N - (h & (N - 1)); // up to the end of the storage
+    *n = (free < run)? free : run;
+    return &buffer[h & (N - 1)];
+  }
+
+  // Publish n elements written after reserve()
+  void commit(uint32_t n) {
+    __atomic_store_n(&head, head + n, __ATOMIC_RELEASE);
+  }
+
+  // Contiguous elements to read in place, n is set to their number
+  const T *peek(uint32_t *n) {
+    uint32_t t = tail;
+    uint32_t used = __atomic_load_n(&head, __ATOMIC_ACQUIRE) - t;
+    uint32_t run = N - (t & (N - 1));
+    *n = (used < run)? used : run;
+    return &buffer[t & (N - 1)];
+  }
+
+  // Release n elements read after peek()
+  void consume(uint32_t n) {
+    __atomic_store_n(&tail, tail + n, __ATOMIC_RELEASE);
+  }
+
+private:
+
+  uint32_t head __attribute__((aligned(RING_BUFFER_ALIGN))); // next write
+  uint32_t tail __attribute__((aligned(RING_BUFFER_ALIGN))); // next read
+  T buffer[N] __attribute__((aligned(RING_BUFFER_ALIGN)));
+
+  ring_buffer(const ring_buffer &);
+  ring_buffer &operator=(const ring_buffer &);
+};
+
+} // namespace dsp
+
+
+#endif // __CPP98_RING_BUFFER_H_
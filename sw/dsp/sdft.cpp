@@ -0,0 +1,72 @@
+/* sdft.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the Sliding Discrete
+ * Fourier Transform [2].
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Jacobsen, E.; Lyons, R., "The sliding DFT," IEEE Signal Processing
+ *      Magazine, vol. 20, no. 2, pp. 74-80, 2003.
+ *  [3] Jacobsen, E.; Lyons, R., "An update to the sliding DFT," IEEE Signal
+ *      Processing Magazine, vol. 21, no. 1, pp. 110-111, 2004.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "sdft.h"
+
+// Sliding DFT initialisation
+void sdft_init(
+  sdft_t *s,    // sliding DFT state.
+  float *x,     // window buffer, float[N].
+  complex_t *X, // DFT bins buffer, complex_t[N/2+1].
+  int N,        // DFT size.
+  float r) {    // damping factor (0 < r ≤ 1).
+
+  int n,k;
+
+  s->N = N;
+  s->n = 0;
+  s->r = r;
+  s->rN = pow(r, N);
+  s->x = x;
+  s->X = X;
+
+  for (n = 0; n < N; n++)
+    x[n] = 0;
+  for (k = 0; k <= N/2; k++)
+    X[k] = complex_num(0, 0);
+}
+
+
+// Sliding DFT update with a new sample
+void sdft_update(
+  sdft_t *s,    // sliding DFT state.
+  float x) {    // new sample.
+
+  int k;
+
+  // x(n) - r^N･x(n-N), and replace the oldest sample
+  float d = x - s->rN*s->x[s->n];
+  s->x[s->n] = x;
+  if (++s->n == s->N)
+    s->n = 0;
+
+  // 0 ≤ k ≤ N/2
+  for (k = 0; k <= s->N/2; k++) {
+    // r･W(N)^(-k) = r･conj(W(N)^k)
+    complex_t w = complex_conj(twiddle(s->N, k));
+    complex_t y = complex_num(s->X[k].real + d, s->X[k].imag);
+    y = complex_mul(y, w);
+    s->X[k] = complex_num(s->r*y.real, s->r*y.imag);
+  }
+}
@@ -0,0 +1,76 @@
+/* sdft.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the Sliding Discrete Fourier
+ * Transform [2].
+ *
+ * The sliding DFT keeps the DFT of the last N samples of a real signal and
+ * updates its N/2+1 unique bins in O(N) operations for every new sample,
+ * instead of recomputing the whole transform for every block of N samples:
+ *
+ *      X[k](n) = r･W(N)^(-k)･(X[k](n-1) + x(n) - r^N･x(n-N))
+ *
+ * The damping factor r < 1 keeps the recursion stable, since its poles are
+ * moved inside the unit circle and rounding errors decay instead of
+ * accumulating [3].
+ *
+ * Sliding DFT state is defined as structure and is associated with the user
+ * defined type:
+ *
+ *                sdft_t
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Jacobsen, E.; Lyons, R., "The sliding DFT," IEEE Signal Processing
+ *      Magazine, vol. 20, no. 2, pp. 74-80, 2003.
+ *  [3] Jacobsen, E.; Lyons, R., "An update to the sliding DFT," IEEE Signal
+ *      Processing Magazine, vol. 21, no. 1, pp. 110-111, 2004.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_SDFT_H_
+#define __C90_SDFT_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "twiddle.h"
+
+// Default damping factor
+#define SDFT_R 0.99999f
+
+// Sliding DFT state
+typedef struct {
+  int N;        // DFT size (window length).
+  int n;        // position of the oldest sample in x.
+  float r;      // damping factor.
+  float rN;     // r^N.
+  float *x;     // last N samples (circular buffer).
+  complex_t *X; // DFT bins, 0 ≤ k ≤ N/2.
+} sdft_t;
+
+
+// Sliding DFT initialisation, clears the window and the bins
+void sdft_init(
+  sdft_t *s,    // sliding DFT state.
+  float *x,     // window buffer, float[N].
+  complex_t *X, // DFT bins buffer, complex_t[N/2+1].
+  int N,        // DFT size.
+  float r);     // damping factor (0 < r ≤ 1), e.g. SDFT_R.
+
+
+// Sliding DFT update with a new sample, O(N)
+void sdft_update(
+  sdft_t *s,    // sliding DFT state.
+  float x);     // new sample.
+
+
+#endif // __C90_SDFT_H_
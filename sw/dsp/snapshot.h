@@ -0,0 +1,133 @@
+/* snapshot.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of a double-buffered snapshot,
+ * through which one producer publishes complete results (e.g. the DFT,
+ * spectrum and PSD of a block) to any number of readers, without locks: the
+ * producer never waits for the readers, and the readers never see a result
+ * that is half written.
+ *
+ * The snapshot is associated with the user defined type:
+ *
+ *                         dsp::snapshot<T>
+ *
+ * The producer writes the back buffer and publishes it by incrementing the
+ * sequence number, which swaps the back and the front buffers: the front
+ * buffer of sequence s is buffer[s & 1]. A reader loads the sequence number
+ * (acquire), reads the front buffer and validates the read, i.e. the
+ * sequence number is unchanged, otherwise the producer may have started to
+ * overwrite the buffer and the reader retries [2].
+ *
+ * The counter behind the sequence number is a sequence lock [3]: it is twice
+ * the sequence number, plus 1 while the producer writes the back buffer.
+ * back() makes it odd before the producer writes, with a release fence, so
+ * that a reader that sees any of these writes (they go to the buffer it
+ * reads only after the next publish) also sees the counter change when it
+ * validates, after an acquire fence. The front buffer is not written while
+ * the counter is odd, so the readers do not wait for the producer.
+ *
+ * The following operations are supported:
+ *
+ *  Operations             | Usage                  | Caller
+ *  ---------------------------------------------------------------------------
+ *  Back buffer            | T &b = s.back()        | producer
+ *  Publish                | seq = s.publish()      | producer
+ *  Sequence number        | seq = s.sequence()     | reader
+ *  Front buffer           | f = s.front(seq)       | reader
+ *  Validate a read        | ok = s.valid(seq)      | reader
+ *  Copy the latest        | seq = s.read(&copy)    | reader
+ *
+ * The sequence number starts at 0 (nothing published) and counts the
+ * published results, modulo 2^31. T must not change its storage while the
+ * readers access it (e.g. a std::vector is resized only while there are no
+ * readers).
+ *
+ * Dependencies:
+ *  "stdint.h", GCC __atomic built-ins
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] Lameter, C., "Effective Synchronization on Linux/NUMA Systems,"
+ *      Gelato Conference, 2005 (sequence locks).
+ *  [3] Boehm, H.-J., "Can Seqlocks Get Along with Programming Language
+ *      Memory Models?," MSPC '12, ACM, 2012, pp. 12-20.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_SNAPSHOT_H_
+#define __CPP98_SNAPSHOT_H_
+
+#include <stdint.h>
+
+namespace dsp {
+
+template <typename T>
+class snapshot {
+public:
+
+  snapshot() : seq(0) {}
+
+  // Buffer of the next result, to be written before publish() (producer)
+  T &back() {
+    uint32_t c = seq | 1; // owned by the producer
+    if (c != seq) {
+      __atomic_store_n(&seq, c, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_RELEASE); // before the writes
+    }
+    return buffer[((c >> 1) + 1) & 1];
+  }
+
+  // Both buffers, e.g. to size them while there are no readers (producer)
+  T &buffers(int i) { return buffer[i & 1]; }
+
+  // Publish the back buffer, returns its sequence number (producer)
+  uint32_t publish() {
+    uint32_t c = (seq | 1) + 1;
+    __atomic_store_n(&seq, c, __ATOMIC_RELEASE);
+    return c >> 1;
+  }
+
+  // Sequence number of the latest result
+  uint32_t sequence() const {
+    return __atomic_load_n(&seq, __ATOMIC_ACQUIRE) >> 1;
+  }
+
+  // Result of sequence number s
+  const T &front(uint32_t s) const { return buffer[s & 1]; }
+
+  // True if the reads of the result of s are complete, i.e. the producer has
+  // not published since
+  bool valid(uint32_t s) const {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE); // after the reads
+    return (__atomic_load_n(&seq, __ATOMIC_RELAXED) >> 1) == s;
+  }
+
+  // Copy the latest result, returns its sequence number
+  uint32_t read(T *copy) const {
+    uint32_t s;
+    do {
+      s = sequence();
+      *copy = front(s);
+    } while (!valid(s));
+    return s;
+  }
+
+private:
+
+  T buffer[2];
+  uint32_t seq; // 2 x sequence number, + 1 while the back buffer is written
+
+  snapshot(const snapshot &);
+  snapshot &operator=(const snapshot &);
+};
+
+} // namespace dsp
+
+
+#endif // __CPP98_SNAPSHOT_H_
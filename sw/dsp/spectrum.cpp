@@ -0,0 +1,107 @@
+/* spectrum.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the fused spectrum and
+ * PSD post-processing stage.
+ *
+ * Dependencies:
+ *  "complex_numbers.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "spectrum.h"
+
+// Spread bins k = n+1 and k+1 to points 2n and 2n+1, from their power p and
+// magnitude m
+static void spread(
+  float *spectrum, // output spectrum, or NULL.
+  float *Pxx,      // output PSD, or NULL.
+  int n,           // output pair, 0 ≤ n ≤ N/2-2.
+  float p1,        // power of bin n+1.
+  float m1,        // magnitude of bin n+1.
+  float m2,        // magnitude of bin n+2.
+  float as,        // amplitude scale.
+  float ps) {      // density scale.
+
+  float avg = (m1 + m2)/2;
+
+  if (spectrum != NULL) {
+    spectrum[2*n] = m1*as;
+    spectrum[2*n + 1] = avg*as;
+  }
+  if (Pxx != NULL) {
+    Pxx[2*n] = 10*log10f(p1*ps);
+    Pxx[2*n + 1] = 10*log10f(avg*avg*ps);
+  }
+}
+
+
+// Zero the last two points
+static void spread_tail(
+  float *spectrum, // output spectrum, or NULL.
+  float *Pxx,      // output PSD, or NULL.
+  int N) {         // DFT size.
+
+  if (spectrum != NULL)
+    spectrum[N - 2] = spectrum[N - 1] = 0;
+  if (Pxx != NULL)
+    Pxx[N - 2] = Pxx[N - 1] = 0;
+}
+
+
+// Spectrum and PSD of the DFT bins X[0..N/2] of a real signal
+void spectrum_psd(
+  float *spectrum,    // output spectrum, float[N], or NULL.
+  float *Pxx,         // output PSD, float[N], or NULL.
+  const complex_t *X, // DFT bins, N/2+1.
+  int N,              // DFT size (N ≥ 4).
+  float as,           // amplitude scale.
+  float ps) {         // density scale.
+
+  int n;
+
+  // |X[k]|^2 and |X[k]| once per bin, carried to the next pair
+  float p1 = X[1].real*X[1].real + X[1].imag*X[1].imag;
+  float m1 = sqrtf(p1);
+  for (n = 0; n < N/2 - 1; n++) {
+    float p2 = X[n + 2].real*X[n + 2].real + X[n + 2].imag*X[n + 2].imag;
+    float m2 = sqrtf(p2);
+    spread(spectrum, Pxx, n, p1, m1, m2, as, ps);
+    p1 = p2;
+    m1 = m2;
+  }
+
+  spread_tail(spectrum, Pxx, N);
+}
+
+
+// Spectrum and PSD of the power bins P[0..N/2] = |X|^2 of a real signal
+void spectrum_psd_power(
+  float *spectrum,    // output spectrum, float[N], or NULL.
+  float *Pxx,         // output PSD, float[N], or NULL.
+  const float *P,     // power bins, N/2+1.
+  int N,              // DFT size (N ≥ 4).
+  float as,           // amplitude scale.
+  float ps) {         // density scale.
+
+  int n;
+
+  // |X[k]| once per bin, carried to the next pair
+  float m1 = sqrtf(P[1]);
+  for (n = 0; n < N/2 - 1; n++) {
+    float m2 = sqrtf(P[n + 2]);
+    spread(spectrum, Pxx, n, P[n + 1], m1, m2, as, ps);
+    m1 = m2;
+  }
+
+  spread_tail(spectrum, Pxx, N);
+}
@@ -0,0 +1,69 @@
+/* spectrum.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the post-processing stage,
+ * which turns the N/2+1 unique DFT bins of a real signal of N samples into
+ * the amplitude spectrum and the Power Spectral Density (PSD) displayed by
+ * the application.
+ *
+ * DC component and AC aliases are removed and the rest of the bins are
+ * spread over N points, every bin k = n+1 (0 ≤ n ≤ N/2-2) is followed by the
+ * average of bins k and k+1:
+ *
+ *      spectrum[2n]   = as･|X[n+1]|
+ *      spectrum[2n+1] = as･(|X[n+1]| + |X[n+2]|)/2
+ *      Pxx[2n]        = 10･log10(ps･|X[n+1]|^2)
+ *      Pxx[2n+1]      = 10･log10(ps･((|X[n+1]| + |X[n+2]|)/2)^2)
+ *
+ * and the last two points are 0. The scales as and ps are the amplitude and
+ * density scales of the window (see window.h).
+ *
+ * The stage is fused: the squared magnitude of every bin is computed once,
+ * and both outputs are derived from it with one square root per bin. It
+ * accepts either the bins X, or their power |X|^2 (e.g. the averaged
+ * periodogram of the Welch estimator).
+ *
+ * Dependencies:
+ *  "complex_numbers.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_SPECTRUM_H_
+#define __C90_SPECTRUM_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+
+
+// Spectrum and PSD of the DFT bins X[0..N/2] of a real signal
+// Either output may be NULL, if it is not needed.
+void spectrum_psd(
+  float *spectrum,    // output spectrum, float[N], or NULL.
+  float *Pxx,         // output PSD, float[N], or NULL.
+  const complex_t *X, // DFT bins, N/2+1.
+  int N,              // DFT size (N ≥ 4).
+  float as,           // amplitude scale.
+  float ps);          // density scale.
+
+
+// Spectrum and PSD of the power bins P[0..N/2] = |X|^2 of a real signal
+// Either output may be NULL, if it is not needed.
+void spectrum_psd_power(
+  float *spectrum,    // output spectrum, float[N], or NULL.
+  float *Pxx,         // output PSD, float[N], or NULL.
+  const float *P,     // power bins, N/2+1.
+  int N,              // DFT size (N ≥ 4).
+  float as,           // amplitude scale.
+  float ps);          // density scale.
+
+
+#endif // __C90_SPECTRUM_H_
@@ -0,0 +1,395 @@
+/* twiddle.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the twiddle factors [2]
+ *
+ *      W(N)^k = exp(-j･2𝜋k/N)
+ *
+ * used by the DFT and FFT kernels.
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 652-654,729-730.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "twiddle.h"
+
+#define TWIDDLE_Q (TWIDDLE_NMAX/4) // quarter-wave length
+
+// Quarter-wave sine table, sin(2𝜋q/TWIDDLE_NMAX), 0 ≤ q ≤ TWIDDLE_NMAX/4
+static const float sinq[TWIDDLE_Q + 1] = {
+  0.000000000f, 0.001533980f, 0.003067957f, 0.004601926f, 0.006135885f, 0.007669829f,
+  0.009203755f, 0.010737659f, 0.012271538f, 0.013805389f, 0.015339206f, 0.016872988f,
+  0.018406730f, 0.019940429f, 0.021474080f, 0.023007681f, 0.024541229f, 0.026074718f,
+  0.027608146f, 0.029141509f, 0.030674803f, 0.032208025f, 0.033741172f, 0.035274239f,
+  0.036807223f, 0.038340120f, 0.039872928f, 0.041405641f, 0.042938257f, 0.044470772f,
+  0.046003182f, 0.047535484f, 0.049067674f, 0.050599749f, 0.052131705f, 0.053663538f,
+  0.055195244f, 0.056726821f, 0.058258265f, 0.059789571f, 0.061320736f, 0.062851758f,
+  0.064382631f, 0.065913353f, 0.067443920f, 0.068974328f, 0.070504573f, 0.072034653f,
+  0.073564564f, 0.075094301f, 0.076623861f, 0.078153242f, 0.079682438f, 0.081211447f,
+  0.082740265f, 0.084268888f, 0.085797312f, 0.087325535f, 0.088853553f, 0.090381361f,
+  0.091908956f, 0.093436336f, 0.094963495f, 0.096490431f, 0.098017140f, 0.099543619f,
+  0.101069863f, 0.102595869f, 0.104121634f, 0.105647154f, 0.107172425f, 0.108697444f,
+  0.110222207f, 0.111746711f, 0.113270952f, 0.114794927f, 0.116318631f, 0.117842062f,
+  0.119365215f, 0.120888087f, 0.122410675f, 0.123932975f, 0.125454983f, 0.126976696f,
+  0.128498111f, 0.130019223f, 0.131540029f, 0.133060525f, 0.134580709f, 0.136100575f,
+  0.137620122f, 0.139139344f, 0.140658239f, 0.142176804f, 0.143695033f, 0.145212925f,
+  0.146730474f, 0.148247679f, 0.149764535f, 0.151281038f, 0.152797185f, 0.154312973f,
+  0.155828398f, 0.157343456f, 0.158858143f, 0.160372457f, 0.161886394f, 0.163399949f,
+  0.164913120f, 0.166425904f, 0.167938295f, 0.169450291f, 0.170961889f, 0.172473084f,
+  0.173983873f, 0.175494253f, 0.177004220f, 0.178513771f, 0.180022901f, 0.181531608f,
+  0.183039888f, 0.184547737f, 0.186055152f, 0.187562129f, 0.189068664f, 0.190574755f,
+  0.192080397f, 0.193585587f, 0.195090322f, 0.196594598f, 0.198098411f, 0.199601758f,
+  0.201104635f, 0.202607039f, 0.204108966f, 0.205610413f, 0.207111376f, 0.208611852f,
+  0.210111837f, 0.211611327f, 0.213110320f, 0.214608811f, 0.216106797f, 0.217604275f,
+  0.219101240f, 0.220597690f, 0.222093621f, 0.223589029f, 0.225083911f, 0.226578264f,
+  0.228072083f, 0.229565366f, 0.231058108f, 0.232550307f, 0.234041959f, 0.235533059f,
+  0.237023606f, 0.238513595f, 0.240003022f, 0.241491885f, 0.242980180f, 0.244467903f,
+  0.245955050f, 0.247441619f, 0.248927606f, 0.250413007f, 0.251897818f, 0.253382037f,
+  0.254865660f, 0.256348682f, 0.257831102f, 0.259312915f, 0.260794118f, 0.262274707f,
+  0.263754679f, 0.265234030f, 0.266712757f, 0.268190857f, 0.269668326f, 0.271145160f,
+  0.272621355f, 0.274096910f, 0.275571819f, 0.277046080f, 0.278519689f, 0.279992643f,
+  0.281464938f, 0.282936570f, 0.284407537f, 0.285877835f, 0.287347460f, 0.288816408f,
+  0.290284677f, 0.291752263f, 0.293219163f, 0.294685372f, 0.296150888f, 0.297615707f,
+  0.299079826f, 0.300543241f, 0.302005949f, 0.303467947f, 0.304929230f, 0.306389795f,
+  0.307849640f, 0.309308760f, 0.310767153f, 0.312224814f, 0.313681740f, 0.315137929f,
+  0.316593376f, 0.318048077f, 0.319502031f, 0.320955232f, 0.322407679f, 0.323859367f,
+  0.325310292f, 0.326760452f, 0.328209844f, 0.329658463f, 0.331106306f, 0.332553370f,
+  0.333999651f, 0.335445147f, 0.336889853f, 0.338333767f, 0.339776884f, 0.341219202f,
+  0.342660717f, 0.344101426f, 0.345541325f, 0.346980411f, 0.348418680f, 0.349856130f,
+  0.351292756f, 0.352728556f, 0.354163525f, 0.355597662f, 0.357030961f, 0.358463421f,
+  0.359895037f, 0.361325806f, 0.362755724f, 0.364184790f, 0.365612998f, 0.367040346f,
+  0.368466830f, 0.369892447f, 0.371317194f, 0.372741067f, 0.374164063f, 0.375586178f,
+  0.377007410f, 0.378427755f, 0.379847209f, 0.381265769f, 0.382683432f, 0.384100195f,
+  0.385516054f, 0.386931006f, 0.388345047f, 0.389758174f, 0.391170384f, 0.392581674f,
+  0.393992040f, 0.395401479f, 0.396809987f, 0.398217562f, 0.399624200f, 0.401029897f,
+  0.402434651f, 0.403838458f, 0.405241314f, 0.406643217f, 0.408044163f, 0.409444149f,
+  0.410843171f, 0.412241227f, 0.413638312f, 0.415034424f, 0.416429560f, 0.417823716f,
+  0.419216888f, 0.420609074f, 0.422000271f, 0.423390474f, 0.424779681f, 0.426167889f,
+  0.427555093f, 0.428941292f, 0.430326481f, 0.431710658f, 0.433093819f, 0.434475961f,
+  0.435857080f, 0.437237174f, 0.438616239f, 0.439994271f, 0.441371269f, 0.442747228f,
+  0.444122145f, 0.445496017f, 0.446868840f, 0.448240612f, 0.449611330f, 0.450980989f,
+  0.452349587f, 0.453717121f, 0.455083587f, 0.456448982f, 0.457813304f, 0.459176548f,
+  0.460538711f, 0.461899791f, 0.463259784f, 0.464618686f, 0.465976496f, 0.467333209f,
+  0.468688822f, 0.470043332f, 0.471396737f, 0.472749032f, 0.474100215f, 0.475450282f,
+  0.476799230f, 0.478147056f, 0.479493758f, 0.480839331f, 0.482183772f, 0.483527079f,
+  0.484869248f, 0.486210276f, 0.487550160f, 0.488888897f, 0.490226483f, 0.491562916f,
+  0.492898192f, 0.494232309f, 0.495565262f, 0.496897049f, 0.498227667f, 0.499557113f,
+  0.500885383f, 0.502212474f, 0.503538384f, 0.504863109f, 0.506186645f, 0.507508991f,
+  0.508830143f, 0.510150097f, 0.511468850f, 0.512786401f, 0.514102744f, 0.515417878f,
+  0.516731799f, 0.518044504f, 0.519355990f, 0.520666254f, 0.521975293f, 0.523283103f,
+  0.524589683f, 0.525895027f, 0.527199135f, 0.528502002f, 0.529803625f, 0.531104001f,
+  0.532403128f, 0.533701002f, 0.534997620f, 0.536292979f, 0.537587076f, 0.538879909f,
+  0.540171473f, 0.541461766f, 0.542750785f, 0.544038527f, 0.545324988f, 0.546610167f,
+  0.547894059f, 0.549176662f, 0.550457973f, 0.551737988f, 0.553016706f, 0.554294121f,
+  0.555570233f, 0.556845037f, 0.558118531f, 0.559390712f, 0.560661576f, 0.561931121f,
+  0.563199344f, 0.564466242f, 0.565731811f, 0.566996049f, 0.568258953f, 0.569520519f,
+  0.570780746f, 0.572039629f, 0.573297167f, 0.574553355f, 0.575808191f, 0.577061673f,
+  0.578313796f, 0.579564559f, 0.580813958f, 0.582061990f, 0.583308653f, 0.584553943f,
+  0.585797857f, 0.587040394f, 0.588281548f, 0.589521319f, 0.590759702f, 0.591996695f,
+  0.593232295f, 0.594466499f, 0.595699304f, 0.596930708f, 0.598160707f, 0.599389298f,
+  0.600616479f, 0.601842247f, 0.603066599f, 0.604289531f, 0.605511041f, 0.606731127f,
+  0.607949785f, 0.609167012f, 0.610382806f, 0.611597164f, 0.612810082f, 0.614021559f,
+  0.615231591f, 0.616440175f, 0.617647308f, 0.618852988f, 0.620057212f, 0.621259977f,
+  0.622461279f, 0.623661118f, 0.624859488f, 0.626056388f, 0.627251815f, 0.628445767f,
+  0.629638239f, 0.630829230f, 0.632018736f, 0.633206755f, 0.634393284f, 0.635578320f,
+  0.636761861f, 0.637943904f, 0.639124445f, 0.640303482f, 0.641481013f, 0.642657034f,
+  0.643831543f, 0.645004537f, 0.646176013f, 0.647345969f, 0.648514401f, 0.649681307f,
+  0.650846685f, 0.652010531f, 0.653172843f, 0.654333618f, 0.655492853f, 0.656650546f,
+  0.657806693f, 0.658961293f, 0.660114342f, 0.661265838f, 0.662415778f, 0.663564159f,
+  0.664710978f, 0.665856234f, 0.666999922f, 0.668142041f, 0.669282588f, 0.670421560f,
+  0.671558955f, 0.672694769f, 0.673829000f, 0.674961646f, 0.676092704f, 0.677222170f,
+  0.678350043f, 0.679476320f, 0.680600998f, 0.681724074f, 0.682845546f, 0.683965412f,
+  0.685083668f, 0.686200312f, 0.687315341f, 0.688428753f, 0.689540545f, 0.690650714f,
+  0.691759258f, 0.692866175f, 0.693971461f, 0.695075114f, 0.696177131f, 0.697277511f,
+  0.698376249f, 0.699473345f, 0.700568794f, 0.701662595f, 0.702754744f, 0.703845241f,
+  0.704934080f, 0.706021261f, 0.707106781f, 0.708190637f, 0.709272826f, 0.710353347f,
+  0.711432196f, 0.712509371f, 0.713584869f, 0.714658688f, 0.715730825f, 0.716801279f,
+  0.717870045f, 0.718937122f, 0.720002508f, 0.721066199f, 0.722128194f, 0.723188489f,
+  0.724247083f, 0.725303972f, 0.726359155f, 0.727412629f, 0.728464390f, 0.729514438f,
+  0.730562769f, 0.731609381f, 0.732654272f, 0.733697438f, 0.734738878f, 0.735778589f,
+  0.736816569f, 0.737852815f, 0.738887324f, 0.739920095f, 0.740951125f, 0.741980412f,
+  0.743007952f, 0.744033744f, 0.745057785f, 0.746080074f, 0.747100606f, 0.748119380f,
+  0.749136395f, 0.750151646f, 0.751165132f, 0.752176850f, 0.753186799f, 0.754194975f,
+  0.755201377f, 0.756206001f, 0.757208847f, 0.758209910f, 0.759209189f, 0.760206682f,
+  0.761202385f, 0.762196298f, 0.763188417f, 0.764178741f, 0.765167266f, 0.766153990f,
+  0.767138912f, 0.768122029f, 0.769103338f, 0.770082837f, 0.771060524f, 0.772036397f,
+  0.773010453f, 0.773982691f, 0.774953107f, 0.775921699f, 0.776888466f, 0.777853404f,
+  0.778816512f, 0.779777788f, 0.780737229f, 0.781694832f, 0.782650596f, 0.783604519f,
+  0.784556597f, 0.785506830f, 0.786455214f, 0.787401747f, 0.788346428f, 0.789289253f,
+  0.790230221f, 0.791169330f, 0.792106577f, 0.793041960f, 0.793975478f, 0.794907126f,
+  0.795836905f, 0.796764810f, 0.797690841f, 0.798614995f, 0.799537269f, 0.800457662f,
+  0.801376172f, 0.802292796f, 0.803207531f, 0.804120377f, 0.805031331f, 0.805940391f,
+  0.806847554f, 0.807752818f, 0.808656182f, 0.809557642f, 0.810457198f, 0.811354847f,
+  0.812250587f, 0.813144415f, 0.814036330f, 0.814926329f, 0.815814411f, 0.816700573f,
+  0.817584813f, 0.818467130f, 0.819347520f, 0.820225983f, 0.821102515f, 0.821977115f,
+  0.822849781f, 0.823720511f, 0.824589303f, 0.825456154f, 0.826321063f, 0.827184027f,
+  0.828045045f, 0.828904115f, 0.829761234f, 0.830616400f, 0.831469612f, 0.832320868f,
+  0.833170165f, 0.834017501f, 0.834862875f, 0.835706284f, 0.836547727f, 0.837387202f,
+  0.838224706f, 0.839060237f, 0.839893794f, 0.840725375f, 0.841554977f, 0.842382600f,
+  0.843208240f, 0.844031895f, 0.844853565f, 0.845673247f, 0.846490939f, 0.847306639f,
+  0.848120345f, 0.848932055f, 0.849741768f, 0.850549481f, 0.851355193f, 0.852158902f,
+  0.852960605f, 0.853760301f, 0.854557988f, 0.855353665f, 0.856147328f, 0.856938977f,
+  0.857728610f, 0.858516224f, 0.859301818f, 0.860085390f, 0.860866939f, 0.861646461f,
+  0.862423956f, 0.863199422f, 0.863972856f, 0.864744258f, 0.865513624f, 0.866280954f,
+  0.867046246f, 0.867809497f, 0.868570706f, 0.869329871f, 0.870086991f, 0.870842063f,
+  0.871595087f, 0.872346059f, 0.873094978f, 0.873841843f, 0.874586652f, 0.875329403f,
+  0.876070094f, 0.876808724f, 0.877545290f, 0.878279792f, 0.879012226f, 0.879742593f,
+  0.880470889f, 0.881197113f, 0.881921264f, 0.882643340f, 0.883363339f, 0.884081259f,
+  0.884797098f, 0.885510856f, 0.886222530f, 0.886932119f, 0.887639620f, 0.888345033f,
+  0.889048356f, 0.889749586f, 0.890448723f, 0.891145765f, 0.891840709f, 0.892533555f,
+  0.893224301f, 0.893912945f, 0.894599486f, 0.895283921f, 0.895966250f, 0.896646470f,
+  0.897324581f, 0.898000580f, 0.898674466f, 0.899346237f, 0.900015892f, 0.900683429f,
+  0.901348847f, 0.902012144f, 0.902673318f, 0.903332368f, 0.903989293f, 0.904644091f,
+  0.905296759f, 0.905947298f, 0.906595705f, 0.907241978f, 0.907886116f, 0.908528119f,
+  0.909167983f, 0.909805708f, 0.910441292f, 0.911074734f, 0.911706032f, 0.912335185f,
+  0.912962190f, 0.913587048f, 0.914209756f, 0.914830312f, 0.915448716f, 0.916064966f,
+  0.916679060f, 0.917290997f, 0.917900776f, 0.918508394f, 0.919113852f, 0.919717146f,
+  0.920318277f, 0.920917242f, 0.921514039f, 0.922108669f, 0.922701128f, 0.923291417f,
+  0.923879533f, 0.924465474f, 0.925049241f, 0.925630831f, 0.926210242f, 0.926787474f,
+  0.927362526f, 0.927935395f, 0.928506080f, 0.929074581f, 0.929640896f, 0.930205023f,
+  0.930766961f, 0.931326709f, 0.931884266f, 0.932439629f, 0.932992799f, 0.933543773f,
+  0.934092550f, 0.934639130f, 0.935183510f, 0.935725689f, 0.936265667f, 0.936803442f,
+  0.937339012f, 0.937872376f, 0.938403534f, 0.938932484f, 0.939459224f, 0.939983753f,
+  0.940506071f, 0.941026175f, 0.941544065f, 0.942059740f, 0.942573198f, 0.943084437f,
+  0.943593458f, 0.944100258f, 0.944604837f, 0.945107193f, 0.945607325f, 0.946105232f,
+  0.946600913f, 0.947094366f, 0.947585591f, 0.948074586f, 0.948561350f, 0.949045882f,
+  0.949528181f, 0.950008245f, 0.950486074f, 0.950961666f, 0.951435021f, 0.951906137f,
+  0.952375013f, 0.952841648f, 0.953306040f, 0.953768190f, 0.954228095f, 0.954685755f,
+  0.955141168f, 0.955594334f, 0.956045251f, 0.956493919f, 0.956940336f, 0.957384501f,
+  0.957826413f, 0.958266071f, 0.958703475f, 0.959138622f, 0.959571513f, 0.960002146f,
+  0.960430519f, 0.960856633f, 0.961280486f, 0.961702077f, 0.962121404f, 0.962538468f,
+  0.962953267f, 0.963365800f, 0.963776066f, 0.964184064f, 0.964589793f, 0.964993253f,
+  0.965394442f, 0.965793359f, 0.966190003f, 0.966584374f, 0.966976471f, 0.967366292f,
+  0.967753837f, 0.968139105f, 0.968522094f, 0.968902805f, 0.969281235f, 0.969657385f,
+  0.970031253f, 0.970402839f, 0.970772141f, 0.971139158f, 0.971503891f, 0.971866337f,
+  0.972226497f, 0.972584369f, 0.972939952f, 0.973293246f, 0.973644250f, 0.973992962f,
+  0.974339383f, 0.974683511f, 0.975025345f, 0.975364885f, 0.975702130f, 0.976037079f,
+  0.976369731f, 0.976700086f, 0.977028143f, 0.977353900f, 0.977677358f, 0.977998515f,
+  0.978317371f, 0.978633924f, 0.978948175f, 0.979260123f, 0.979569766f, 0.979877104f,
+  0.980182136f, 0.980484862f, 0.980785280f, 0.981083391f, 0.981379193f, 0.981672686f,
+  0.981963869f, 0.982252741f, 0.982539302f, 0.982823551f, 0.983105487f, 0.983385110f,
+  0.983662419f, 0.983937413f, 0.984210092f, 0.984480455f, 0.984748502f, 0.985014231f,
+  0.985277642f, 0.985538735f, 0.985797509f, 0.986053963f, 0.986308097f, 0.986559910f,
+  0.986809402f, 0.987056571f, 0.987301418f, 0.987543942f, 0.987784142f, 0.988022017f,
+  0.988257568f, 0.988490793f, 0.988721692f, 0.988950265f, 0.989176510f, 0.989400428f,
+  0.989622017f, 0.989841278f, 0.990058210f, 0.990272812f, 0.990485084f, 0.990695025f,
+  0.990902635f, 0.991107914f, 0.991310860f, 0.991511473f, 0.991709754f, 0.991905700f,
+  0.992099313f, 0.992290591f, 0.992479535f, 0.992666142f, 0.992850414f, 0.993032350f,
+  0.993211949f, 0.993389211f, 0.993564136f, 0.993736722f, 0.993906970f, 0.994074879f,
+  0.994240449f, 0.994403680f, 0.994564571f, 0.994723121f, 0.994879331f, 0.995033199f,
+  0.995184727f, 0.995333912f, 0.995480755f, 0.995625256f, 0.995767414f, 0.995907229f,
+  0.996044701f, 0.996179829f, 0.996312612f, 0.996443051f, 0.996571146f, 0.996696895f,
+  0.996820299f, 0.996941358f, 0.997060070f, 0.997176437f, 0.997290457f, 0.997402130f,
+  0.997511456f, 0.997618435f, 0.997723067f, 0.997825350f, 0.997925286f, 0.998022874f,
+  0.998118113f, 0.998211003f, 0.998301545f, 0.998389737f, 0.998475581f, 0.998559074f,
+  0.998640218f, 0.998719012f, 0.998795456f, 0.998869550f, 0.998941293f, 0.999010686f,
+  0.999077728f, 0.999142419f, 0.999204759f, 0.999264747f, 0.999322385f, 0.999377670f,
+  0.999430605f, 0.999481187f, 0.999529418f, 0.999575296f, 0.999618822f, 0.999659997f,
+  0.999698819f, 0.999735288f, 0.999769405f, 0.999801170f, 0.999830582f, 0.999857641f,
+  0.999882347f, 0.999904701f, 0.999924702f, 0.999942350f, 0.999957645f, 0.999970586f,
+  0.999981175f, 0.999989411f, 0.999995294f, 0.999998823f, 1.000000000f
+};
+
+// Quarter-wave sine table in Q15, sin(2𝜋q/TWIDDLE_NMAX)･2^15
+static const q15_t sinq_q15[TWIDDLE_Q + 1] = {
+  0, 50, 101, 151, 201, 251, 302, 352, 402, 452, 503, 553,
+  603, 653, 704, 754, 804, 854, 905, 955, 1005, 1055, 1106, 1156,
+  1206, 1256, 1307, 1357, 1407, 1457, 1507, 1558, 1608, 1658, 1708, 1758,
+  1809, 1859, 1909, 1959, 2009, 2059, 2110, 2160, 2210, 2260, 2310, 2360,
+  2410, 2461, 2511, 2561, 2611, 2661, 2711, 2761, 2811, 2861, 2911, 2962,
+  3012, 3062, 3112, 3162, 3212, 3262, 3312, 3362, 3412, 3462, 3512, 3562,
+  3612, 3662, 3712, 3761, 3811, 3861, 3911, 3961, 4011, 4061, 4111, 4161,
+  4210, 4260, 4310, 4360, 4410, 4460, 4509, 4559, 4609, 4659, 4708, 4758,
+  4808, 4858, 4907, 4957, 5007, 5056, 5106, 5156, 5205, 5255, 5305, 5354,
+  5404, 5453, 5503, 5552, 5602, 5651, 5701, 5750, 5800, 5849, 5899, 5948,
+  5998, 6047, 6096, 6146, 6195, 6245, 6294, 6343, 6393, 6442, 6491, 6540,
+  6590, 6639, 6688, 6737, 6786, 6836, 6885, 6934, 6983, 7032, 7081, 7130,
+  7179, 7228, 7277, 7326, 7375, 7424, 7473, 7522, 7571, 7620, 7669, 7718,
+  7767, 7815, 7864, 7913, 7962, 8010, 8059, 8108, 8157, 8205, 8254, 8303,
+  8351, 8400, 8448, 8497, 8545, 8594, 8642, 8691, 8739, 8788, 8836, 8885,
+  8933, 8981, 9030, 9078, 9126, 9175, 9223, 9271, 9319, 9367, 9416, 9464,
+  9512, 9560, 9608, 9656, 9704, 9752, 9800, 9848, 9896, 9944, 9992, 10039,
+  10087, 10135, 10183, 10231, 10278, 10326, 10374, 10421, 10469, 10517, 10564, 10612,
+  10659, 10707, 10754, 10802, 10849, 10897, 10944, 10992, 11039, 11086, 11133, 11181,
+  11228, 11275, 11322, 11370, 11417, 11464, 11511, 11558, 11605, 11652, 11699, 11746,
+  11793, 11840, 11886, 11933, 11980, 12027, 12074, 12120, 12167, 12214, 12260, 12307,
+  12353, 12400, 12446, 12493, 12539, 12586, 12632, 12679, 12725, 12771, 12817, 12864,
+  12910, 12956, 13002, 13048, 13094, 13141, 13187, 13233, 13279, 13324, 13370, 13416,
+  13462, 13508, 13554, 13599, 13645, 13691, 13736, 13782, 13828, 13873, 13919, 13964,
+  14010, 14055, 14101, 14146, 14191, 14236, 14282, 14327, 14372, 14417, 14462, 14507,
+  14553, 14598, 14643, 14688, 14732, 14777, 14822, 14867, 14912, 14956, 15001, 15046,
+  15090, 15135, 15180, 15224, 15269, 15313, 15358, 15402, 15446, 15491, 15535, 15579,
+  15623, 15667, 15712, 15756, 15800, 15844, 15888, 15932, 15976, 16019, 16063, 16107,
+  16151, 16195, 16238, 16282, 16325, 16369, 16413, 16456, 16499, 16543, 16586, 16630,
+  16673, 16716, 16759, 16802, 16846, 16889, 16932, 16975, 17018, 17061, 17104, 17146,
+  17189, 17232, 17275, 17317, 17360, 17403, 17445, 17488, 17530, 17573, 17615, 17657,
+  17700, 17742, 17784, 17827, 17869, 17911, 17953, 17995, 18037, 18079, 18121, 18163,
+  18204, 18246, 18288, 18330, 18371, 18413, 18454, 18496, 18537, 18579, 18620, 18661,
+  18703, 18744, 18785, 18826, 18868, 18909, 18950, 18991, 19032, 19072, 19113, 19154,
+  19195, 19236, 19276, 19317, 19357, 19398, 19438, 19479, 19519, 19560, 19600, 19640,
+  19680, 19721, 19761, 19801, 19841, 19881, 19921, 19961, 20000, 20040, 20080, 20120,
+  20159, 20199, 20238, 20278, 20317, 20357, 20396, 20436, 20475, 20514, 20553, 20592,
+  20631, 20670, 20709, 20748, 20787, 20826, 20865, 20904, 20942, 20981, 21019, 21058,
+  21096, 21135, 21173, 21212, 21250, 21288, 21326, 21364, 21403, 21441, 21479, 21516,
+  21554, 21592, 21630, 21668, 21705, 21743, 21781, 21818, 21856, 21893, 21930, 21968,
+  22005, 22042, 22079, 22116, 22154, 22191, 22227, 22264, 22301, 22338, 22375, 22411,
+  22448, 22485, 22521, 22558, 22594, 22631, 22667, 22703, 22739, 22776, 22812, 22848,
+  22884, 22920, 22956, 22991, 23027, 23063, 23099, 23134, 23170, 23205, 23241, 23276,
+  23311, 23347, 23382, 23417, 23452, 23487, 23522, 23557, 23592, 23627, 23662, 23697,
+  23731, 23766, 23801, 23835, 23870, 23904, 23938, 23973, 24007, 24041, 24075, 24109,
+  24143, 24177, 24211, 24245, 24279, 24312, 24346, 24380, 24413, 24447, 24480, 24514,
+  24547, 24580, 24613, 24647, 24680, 24713, 24746, 24779, 24811, 24844, 24877, 24910,
+  24942, 24975, 25007, 25040, 25072, 25105, 25137, 25169, 25201, 25233, 25265, 25297,
+  25329, 25361, 25393, 25425, 25456, 25488, 25519, 25551, 25582, 25614, 25645, 25676,
+  25708, 25739, 25770, 25801, 25832, 25863, 25893, 25924, 25955, 25986, 26016, 26047,
+  26077, 26108, 26138, 26168, 26198, 26229, 26259, 26289, 26319, 26349, 26378, 26408,
+  26438, 26468, 26497, 26527, 26556, 26586, 26615, 26644, 26674, 26703, 26732, 26761,
+  26790, 26819, 26848, 26876, 26905, 26934, 26962, 26991, 27019, 27048, 27076, 27104,
+  27133, 27161, 27189, 27217, 27245, 27273, 27300, 27328, 27356, 27384, 27411, 27439,
+  27466, 27493, 27521, 27548, 27575, 27602, 27629, 27656, 27683, 27710, 27737, 27764,
+  27790, 27817, 27843, 27870, 27896, 27923, 27949, 27975, 28001, 28027, 28053, 28079,
+  28105, 28131, 28157, 28182, 28208, 28234, 28259, 28284, 28310, 28335, 28360, 28385,
+  28411, 28436, 28460, 28485, 28510, 28535, 28560, 28584, 28609, 28633, 28658, 28682,
+  28706, 28730, 28755, 28779, 28803, 28827, 28850, 28874, 28898, 28922, 28945, 28969,
+  28992, 29016, 29039, 29062, 29085, 29108, 29131, 29154, 29177, 29200, 29223, 29246,
+  29268, 29291, 29313, 29336, 29358, 29380, 29403, 29425, 29447, 29469, 29491, 29513,
+  29534, 29556, 29578, 29599, 29621, 29642, 29664, 29685, 29706, 29728, 29749, 29770,
+  29791, 29812, 29832, 29853, 29874, 29894, 29915, 29936, 29956, 29976, 29997, 30017,
+  30037, 30057, 30077, 30097, 30117, 30136, 30156, 30176, 30195, 30215, 30234, 30253,
+  30273, 30292, 30311, 30330, 30349, 30368, 30387, 30406, 30424, 30443, 30462, 30480,
+  30498, 30517, 30535, 30553, 30571, 30589, 30607, 30625, 30643, 30661, 30679, 30696,
+  30714, 30731, 30749, 30766, 30783, 30800, 30818, 30835, 30852, 30868, 30885, 30902,
+  30919, 30935, 30952, 30968, 30985, 31001, 31017, 31033, 31050, 31066, 31082, 31097,
+  31113, 31129, 31145, 31160, 31176, 31191, 31206, 31222, 31237, 31252, 31267, 31282,
+  31297, 31312, 31327, 31341, 31356, 31371, 31385, 31400, 31414, 31428, 31442, 31456,
+  31470, 31484, 31498, 31512, 31526, 31539, 31553, 31567, 31580, 31593, 31607, 31620,
+  31633, 31646, 31659, 31672, 31685, 31698, 31710, 31723, 31736, 31748, 31760, 31773,
+  31785, 31797, 31809, 31821, 31833, 31845, 31857, 31869, 31880, 31892, 31903, 31915,
+  31926, 31937, 31949, 31960, 31971, 31982, 31993, 32004, 32014, 32025, 32036, 32046,
+  32057, 32067, 32077, 32087, 32098, 32108, 32118, 32128, 32137, 32147, 32157, 32166,
+  32176, 32185, 32195, 32204, 32213, 32223, 32232, 32241, 32250, 32258, 32267, 32276,
+  32285, 32293, 32302, 32310, 32318, 32327, 32335, 32343, 32351, 32359, 32367, 32375,
+  32382, 32390, 32397, 32405, 32412, 32420, 32427, 32434, 32441, 32448, 32455, 32462,
+  32469, 32476, 32482, 32489, 32495, 32502, 32508, 32514, 32521, 32527, 32533, 32539,
+  32545, 32550, 32556, 32562, 32567, 32573, 32578, 32584, 32589, 32594, 32599, 32604,
+  32609, 32614, 32619, 32624, 32628, 32633, 32637, 32642, 32646, 32650, 32655, 32659,
+  32663, 32667, 32671, 32674, 32678, 32682, 32685, 32689, 32692, 32696, 32699, 32702,
+  32705, 32708, 32711, 32714, 32717, 32720, 32722, 32725, 32728, 32730, 32732, 32735,
+  32737, 32739, 32741, 32743, 32745, 32747, 32748, 32750, 32752, 32753, 32755, 32756,
+  32757, 32758, 32759, 32760, 32761, 32762, 32763, 32764, 32765, 32765, 32766, 32766,
+  32766, 32767, 32767, 32767, 32767
+};
+
+// Runtime tables for sizes that do not divide TWIDDLE_NMAX, filled without
+// a lock (build them with twiddle_table(N) before the threads that use them
+// start)
+static struct {
+  int N;
+  complex_t *w;
+} cache[TWIDDLE_CACHE];
+
+
+// Twiddle factor W(N)^k = exp(-j･2𝜋k/N)
+complex_t twiddle(
+  int N,   // transform size.
+  int k) { // exponent.
+
+  if (TWIDDLE_NMAX % N == 0) {
+    // index of 2𝜋k/N on the TWIDDLE_NMAX grid, split in quadrant and offset
+    int i = k*(TWIDDLE_NMAX/N);
+    int r = i % TWIDDLE_Q;
+    float s, c;
+
+    switch (i / TWIDDLE_Q) {
+    case 0:  s =  sinq[r];             c =  sinq[TWIDDLE_Q - r]; break;
+    case 1:  s =  sinq[TWIDDLE_Q - r]; c = -sinq[r];             break;
+    case 2:  s = -sinq[r];             c = -sinq[TWIDDLE_Q - r]; break;
+    default: s = -sinq[TWIDDLE_Q - r]; c =  sinq[r];             break;
+    }
+
+    return complex_num(c, -s);
+  }
+
+  const complex_t *w = twiddle_table(N);
+  if (w != NULL)
+    return w[k];
+
+  // cache is full, evaluate directly
+  return complex_exp(complex_num(0, -2*M_PI*k/N));
+}
+
+
+// Twiddle table W(N)^k, 0 ≤ k ≤ N-1
+const complex_t *twiddle_table(int N) {
+
+  int i,k;
+
+  if (N <= 0 || TWIDDLE_NMAX % N == 0)
+    return NULL; // served by the constant table
+
+  for (i = 0; i < TWIDDLE_CACHE; i++) {
+    if (cache[i].N == N)
+      return cache[i].w;
+    if (cache[i].N == 0)
+      break;
+  }
+  if (i == TWIDDLE_CACHE)
+    return NULL; // cache is full
+
+  // build table once
+  complex_t *w = (complex_t *) malloc(N*sizeof(complex_t));
+  if (w == NULL)
+    return NULL;
+  for (k = 0; k < N; k++)
+    w[k] = complex_exp(complex_num(0, -2*M_PI*k/N));
+
+  cache[i].w = w;
+  cache[i].N = N;
+
+  return w;
+}
+
+
+// Twiddle factor W(N)^k in Q15
+complex_q15_t twiddle_q15(
+  int N,   // transform size.
+  int k) { // exponent.
+
+  complex_q15_t w;
+
+  if (TWIDDLE_NMAX % N == 0) {
+    int i = k*(TWIDDLE_NMAX/N);
+    int r = i % TWIDDLE_Q;
+    q15_t s, c;
+
+    switch (i / TWIDDLE_Q) {
+    case 0:  s =  sinq_q15[r];             c =  sinq_q15[TWIDDLE_Q - r]; break;
+    case 1:  s =  sinq_q15[TWIDDLE_Q - r]; c = -sinq_q15[r];             break;
+    case 2:  s = -sinq_q15[r];             c = -sinq_q15[TWIDDLE_Q - r]; break;
+    default: s = -sinq_q15[TWIDDLE_Q - r]; c =  sinq_q15[r];             break;
+    }
+
+    w.real = c;
+    w.imag = -s;
+    return w;
+  }
+
+  // convert the float factor
+  complex_t wf = twiddle(N, k);
+  w.real = (q15_t) (wf.real*Q15_ONE);
+  w.imag = (q15_t) (wf.imag*Q15_ONE);
+
+  return w;
+}
@@ -0,0 +1,68 @@
+/* twiddle.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the twiddle factors [2]
+ *
+ *      W(N)^k = exp(-j･2𝜋k/N)
+ *
+ * used by the DFT and FFT kernels.
+ *
+ * Twiddle factors are never evaluated with trigonometric functions for sizes
+ * N that divide TWIDDLE_NMAX (every power of two up to TWIDDLE_NMAX). These
+ * are read from constant quarter-wave sine tables (float and Q15), which are
+ * placed in flash. Any other size is served by a table that is built on
+ * first use and kept for the lifetime of the program (up to TWIDDLE_CACHE
+ * sizes), without a lock (see twiddle_table()).
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fixed_point.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 652-654,729-730.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_TWIDDLE_H_
+#define __C90_TWIDDLE_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "fixed_point.h"
+
+// Largest size served by the constant table (power of two)
+#define TWIDDLE_NMAX  4096
+
+// Maximum number of runtime tables (sizes that do not divide TWIDDLE_NMAX)
+#define TWIDDLE_CACHE 4
+
+
+// Twiddle factor W(N)^k = exp(-j･2𝜋k/N), 0 ≤ k ≤ N-1
+complex_t twiddle(
+  int N,  // transform size.
+  int k); // exponent.
+
+
+// Twiddle factor W(N)^k in Q15, 0 ≤ k ≤ N-1
+complex_q15_t twiddle_q15(
+  int N,  // transform size.
+  int k); // exponent.
+
+
+// Twiddle table W(N)^k, 0 ≤ k ≤ N-1, built on first use for sizes that do
+// not divide TWIDDLE_NMAX. Returns NULL for sizes served by the constant
+// table, or if the cache is full or out of memory.
+//
+// The cache is not thread-safe: the first call for such a size (also from
+// twiddle() or the transforms) must not race with other calls.
+const complex_t *twiddle_table(int N);
+
+
+#endif // __C90_TWIDDLE_H_
@@ -0,0 +1,124 @@
+/* welch.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the Welch averaged
+ * periodogram [2].
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fft.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Welch, P. D., "The use of fast Fourier transform for the estimation of
+ *      power spectra," IEEE Transactions on Audio and Electroacoustics,
+ *      vol. 15, no. 2, pp. 70-73, 1967.
+ *  [3] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 842-851.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "welch.h"
+
+// Welch estimator initialisation
+int welch_init(
+  welch_t *e,       // Welch estimator.
+  float *work,      // work buffer, float[WELCH_WORK_SIZE(L)].
+  int L,            // segment length (power of two).
+  int overlap,      // overlap of consecutive segments (samples).
+  const float *w,   // window, float[L], or NULL for rectangular.
+  int Kmax) {       // segments averaged before forgetting, 0 for no limit.
+
+  if (!is_pow2(L) || L < 2 || overlap < 0 || overlap >= L)
+    return -1;
+
+  e->L = L;
+  e->D = L - overlap;
+  e->Kmax = Kmax;
+  e->w = w;
+
+  // carve the work buffer, | x: L | seg: L | X: 2(L/2+1) | P: L/2+1 |
+  e->x = work;
+  e->seg = work + L;
+  e->X = (complex_t *) (work + 2*L);
+  e->P = work + 2*L + 2*(L/2 + 1);
+
+  welch_reset(e);
+
+  return 0;
+}
+
+
+// Clear the average and the buffered samples
+void welch_reset(welch_t *e) {
+
+  int n,k;
+
+  for (n = 0; n < e->L; n++)
+    e->x[n] = 0;
+  for (k = 0; k <= e->L/2; k++)
+    e->P[k] = 0;
+  e->n = 0;
+  e->fill = 0;
+  e->K = 0;
+}
+
+
+// Push a new sample
+int welch_push(
+  welch_t *e,       // Welch estimator.
+  float x) {        // new sample.
+
+  int i,k;
+  int L = e->L;
+
+  e->x[e->n] = x;
+  if (++e->n == L)
+    e->n = 0;
+
+  if (++e->fill < L)
+    return 0;
+  e->fill = L - e->D; // samples shared with the next segment
+
+  // windowed segment, oldest sample first
+  for (i = 0; i < L; i++) {
+    float s = e->x[(e->n + i) & (L - 1)];
+    e->seg[i] = (e->w != NULL)? s*e->w[i] : s;
+  }
+
+  rfft(e->X, e->seg, L);
+
+  // sum of |X|^2, once Kmax segments are in the oldest is forgotten as
+  // sum = sum + |X|^2 - sum/Kmax (exponential average of length Kmax)
+  int forget = (e->Kmax > 0 && e->K >= e->Kmax);
+  for (k = 0; k <= L/2; k++) {
+    float p = e->X[k].real*e->X[k].real + e->X[k].imag*e->X[k].imag;
+    if (forget)
+      e->P[k] += p - e->P[k]/e->K;
+    else
+      e->P[k] += p;
+  }
+  if (!forget)
+    e->K++;
+
+  return 1;
+}
+
+
+// Averaged periodogram P[k] = mean(|Xw[k]|^2)
+int welch_psd(
+  welch_t *e,       // Welch estimator.
+  float *P) {       // output, float[L/2+1].
+
+  int k;
+
+  for (k = 0; k <= e->L/2; k++)
+    P[k] = (e->K > 0)? e->P[k]/e->K : 0;
+
+  return e->K;
+}
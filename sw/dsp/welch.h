@@ -0,0 +1,102 @@
+/* welch.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the Welch averaged periodogram
+ * [2], an estimator of the Power Spectral Density (PSD).
+ *
+ * The signal is split in segments of L samples, which overlap by L-D
+ * samples (e.g. 50% or 75%). Every segment is multiplied by a window and
+ * transformed, and the squared magnitudes of its bins are averaged with the
+ * ones of the previous segments. Averaging K segments reduces the variance
+ * of the estimate by up to K, compared to the single periodogram of a block.
+ *
+ * The estimator is streaming: samples are pushed one at a time and only the
+ * last L samples are kept, so its memory is O(L) however many segments are
+ * averaged. Once Kmax segments are averaged, older segments are forgotten
+ * exponentially, so that the estimate keeps tracking the signal.
+ *
+ * Welch estimator is defined as structure and is associated with the user
+ * defined type:
+ *
+ *                welch_t
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "fft.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Welch, P. D., "The use of fast Fourier transform for the estimation of
+ *      power spectra," IEEE Transactions on Audio and Electroacoustics,
+ *      vol. 15, no. 2, pp. 70-73, 1967.
+ *  [3] Oppenheim, A. V.; Schafer, R. W.,"Discrete-Time Signal Processing,"
+ *      3rd ed., Pearson Prentice Hall, 2010, pp. 842-851.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_WELCH_H_
+#define __C90_WELCH_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "fft.h"
+
+// Overlap of 50% and 75% of a segment of L samples
+#define WELCH_OVERLAP_50(L) ((L)/2)
+#define WELCH_OVERLAP_75(L) (3*(L)/4)
+
+// Size of the work buffer of a segment of L samples (floats)
+#define WELCH_WORK_SIZE(L) (2*(L) + 3*((L)/2 + 1))
+
+// Welch estimator
+typedef struct {
+  int L;          // segment length (power of two).
+  int D;          // hop between segments, L - overlap.
+  int Kmax;       // segments averaged before forgetting, 0 for no limit.
+  const float *w; // window, float[L], or NULL for rectangular.
+  float *x;       // last L samples (circular buffer).
+  int n;          // position of the oldest sample in x.
+  int fill;       // samples in x that belong to the next segment.
+  float *seg;     // windowed segment.
+  complex_t *X;   // DFT of the segment, L/2+1 bins.
+  float *P;       // averaged periodogram, L/2+1 bins.
+  int K;          // number of averaged segments.
+} welch_t;
+
+
+// Welch estimator initialisation
+// Returns 0 on success, -1 if L is not a power of two or the overlap is not
+// in 0..L-1.
+int welch_init(
+  welch_t *e,       // Welch estimator.
+  float *work,      // work buffer, float[WELCH_WORK_SIZE(L)].
+  int L,            // segment length (power of two).
+  int overlap,      // overlap of consecutive segments (samples).
+  const float *w,   // window, float[L] (see window.h), or NULL.
+  int Kmax);        // segments averaged before forgetting, 0 for no limit.
+
+
+// Clear the average and the buffered samples
+void welch_reset(welch_t *e);
+
+
+// Push a new sample, O(1) or O(L･log2(L)) when it completes a segment
+// Returns 1 if a segment was added to the average, 0 otherwise.
+int welch_push(
+  welch_t *e,       // Welch estimator.
+  float x);         // new sample.
+
+
+// Averaged periodogram P[k] = mean(|Xw[k]|^2), 0 ≤ k ≤ L/2, of the windowed
+// segments. Returns the number of averaged segments (P is 0 if none).
+int welch_psd(
+  welch_t *e,       // Welch estimator.
+  float *P);        // output, float[L/2+1].
+
+
+#endif // __C90_WELCH_H_
@@ -0,0 +1,143 @@
+/* window.c
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the window functions [2].
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Harris, F. J., "On the use of windows for harmonic analysis with the
+ *      discrete Fourier transform," Proceedings of the IEEE, vol. 66, no. 1,
+ *      pp. 51-83, 1978.
+ *  [3] Heinzel, G.; Rüdiger, A.; Schilling, R., "Spectrum and spectral
+ *      density estimation by the Discrete Fourier transform (DFT), including
+ *      a comprehensive list of window functions and some new flat-top
+ *      windows," Max-Planck-Institut für Gravitationsphysik, 2002.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "window.h"
+
+// Cosine-sum coefficients, w[n] = Σ (-1)^m･a[m]･cos(2𝜋mn/N), 0 ≤ m ≤ 4
+static const float cosine_sum[5][5] = {
+  { 1.0f,        0,           0,           0,           0           },
+  { 0.5f,        0.5f,        0,           0,           0           },
+  { 0.54f,       0.46f,       0,           0,           0           },
+  { 0.35875f,    0.48829f,    0.14128f,    0.01168f,    0           },
+  { 0.21557895f, 0.41663158f, 0.27726316f, 0.08357895f, 0.00694737f }
+};
+
+// Windows built on first use
+static window_t cache[WINDOW_CACHE];
+static int ncache = 0;
+
+
+// Modified Bessel function of the first kind, order 0
+static float bessel_i0(float x) {
+
+  int k;
+  float sum = 1, term = 1;
+
+  // I0(x) = Σ ((x/2)^k/k!)^2, 0 ≤ k
+  for (k = 1; k < 50 && term > 1e-8f*sum; k++) {
+    float t = x/(2*k);
+    term *= t*t;
+    sum += term;
+  }
+
+  return sum;
+}
+
+
+// Window initialisation
+int window_init(
+  window_t *win, // window.
+  float *w,      // coefficients, float[N].
+  int type,      // window type, WINDOW_*.
+  int N,         // window length.
+  float beta) {  // Kaiser shape parameter (ignored by other types).
+
+  int n,m;
+
+  if (type < WINDOW_RECTANGULAR || type > WINDOW_KAISER || N < 1)
+    return -1;
+
+  if (type == WINDOW_KAISER) {
+    // w[n] = I0(β･√(1 - (2n/N - 1)^2))/I0(β)
+    float i0b = bessel_i0(beta);
+    for (n = 0; n < N; n++) {
+      float r = 2.0f*n/N - 1;
+      w[n] = bessel_i0(beta*sqrt(1 - r*r))/i0b;
+    }
+  } else {
+    // cos(2𝜋mn/N) is the real part of W(N)^(mn mod N)
+    const float *a = cosine_sum[type];
+    for (n = 0; n < N; n++) {
+      float s = a[0];
+      int mn = 0;
+      for (m = 1; m < 5 && a[m] != 0; m++) {
+        mn = (mn + n) % N;
+        float c = twiddle(N, mn).real;
+        s += (m & 1)? -a[m]*c : a[m]*c;
+      }
+      w[n] = s;
+    }
+  }
+
+  // gains
+  float sw = 0, sw2 = 0;
+  for (n = 0; n < N; n++) {
+    sw += w[n];
+    sw2 += w[n]*w[n];
+  }
+
+  win->type = type;
+  win->N = N;
+  win->beta = beta;
+  win->w = w;
+  win->cg = sw/N;
+  win->U = sw2/N;
+  win->enbw = win->U/(win->cg*win->cg);
+
+  return 0;
+}
+
+
+// Window of a given type and length, built on first use
+const window_t *window(
+  int type,      // window type, WINDOW_*.
+  int N,         // window length.
+  float beta) {  // Kaiser shape parameter (ignored by other types).
+
+  int i;
+
+  if (type != WINDOW_KAISER)
+    beta = 0;
+
+  for (i = 0; i < ncache; i++) {
+    window_t *win = &cache[i];
+    if (win->type == type && win->N == N && win->beta == beta)
+      return win;
+  }
+  if (ncache == WINDOW_CACHE)
+    return NULL; // cache is full
+
+  // build table once
+  float *w = (float *) malloc(N*sizeof(float));
+  if (w == NULL)
+    return NULL;
+  if (window_init(&cache[ncache], w, type, N, beta) != 0) {
+    free(w);
+    return NULL;
+  }
+
+  return &cache[ncache++];
+}
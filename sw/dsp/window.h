@@ -0,0 +1,105 @@
+/* window.h
+ *
+ * Author: Petros Fountas
+ * C90 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the definition of the window functions [2]
+ * applied to a block of N samples before its DFT, to reduce the spectral
+ * leakage of components (e.g. the temperature trend) that are not periodic
+ * in the block.
+ *
+ * Windows are periodic (DFT-even), w[n], 0 ≤ n ≤ N-1. The cosine-sum
+ * windows (Hann, Hamming, Blackman-Harris, flat-top) are evaluated from the
+ * twiddle tables, so no trigonometric function is called for the sizes that
+ * are served by the constant tables. The Kaiser window is evaluated from the
+ * series of the Bessel function I0.
+ *
+ * The coefficients are computed once per (type, N) into a table, which is
+ * either provided by the caller (window_init) or built on first use and
+ * kept for the lifetime of the program (window, up to WINDOW_CACHE tables).
+ *
+ * Every window reports its coherent gain and its Equivalent Noise Bandwidth
+ * (ENBW) [3], which scale the amplitude spectrum and the PSD of windowed
+ * blocks:
+ *
+ *      |A[k]| = 2･|Xw[k]|/(N･cg),  PSD[k] = 2･|Xw[k]|^2/(Fs･N･U),
+ *
+ * where cg = Σw[n]/N, U = Σw[n]^2/N and ENBW = U/cg^2 (bins).
+ *
+ * Window is defined as structure and is associated with the user defined
+ * type:
+ *
+ *                window_t
+ *
+ * Dependencies:
+ *  "complex_numbers.h", "twiddle.h", ANSI C90
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C (ISO/IEC 9899:1990)," Geneva,
+ *      Switzerland: ISO, 1990.
+ *  [2] Harris, F. J., "On the use of windows for harmonic analysis with the
+ *      discrete Fourier transform," Proceedings of the IEEE, vol. 66, no. 1,
+ *      pp. 51-83, 1978.
+ *  [3] Heinzel, G.; Rüdiger, A.; Schilling, R., "Spectrum and spectral
+ *      density estimation by the Discrete Fourier transform (DFT), including
+ *      a comprehensive list of window functions and some new flat-top
+ *      windows," Max-Planck-Institut für Gravitationsphysik, 2002.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __C90_WINDOW_H_
+#define __C90_WINDOW_H_
+
+#include "mbed.h"
+#include "complex_numbers.h"
+#include "twiddle.h"
+
+// Window types
+#define WINDOW_RECTANGULAR     0
+#define WINDOW_HANN            1
+#define WINDOW_HAMMING         2
+#define WINDOW_BLACKMAN_HARRIS 3 // 4-term, -92 dB sidelobes
+#define WINDOW_FLAT_TOP        4 // 5-term, amplitude accurate to 0.01 dB
+#define WINDOW_KAISER          5
+
+// Default Kaiser shape parameter (sidelobes about -90 dB)
+#define WINDOW_KAISER_BETA 9.0f
+
+// Maximum number of tables built on first use
+#define WINDOW_CACHE 4
+
+// Window
+typedef struct {
+  int type;   // window type, WINDOW_*.
+  int N;      // window length.
+  float beta; // Kaiser shape parameter (Kaiser only).
+  float *w;   // coefficients, float[N].
+  float cg;   // coherent gain, Σw[n]/N.
+  float U;    // power gain, Σw[n]^2/N.
+  float enbw; // equivalent noise bandwidth, U/cg^2 (bins).
+} window_t;
+
+
+// Window initialisation, computes the coefficients into w
+// Returns 0 on success, -1 if the type is unknown or N < 1.
+int window_init(
+  window_t *win, // window.
+  float *w,      // coefficients, float[N].
+  int type,      // window type, WINDOW_*.
+  int N,         // window length.
+  float beta);   // Kaiser shape parameter (ignored by other types).
+
+
+// Window of a given type and length, built on first use
+// Returns NULL if the type is unknown, or if the cache is full or out of
+// memory.
+const window_t *window(
+  int type,      // window type, WINDOW_*.
+  int N,         // window length.
+  float beta);   // Kaiser shape parameter (ignored by other types).
+
+
+#endif // __C90_WINDOW_H_
@@ -0,0 +1,294 @@
+/* board_sim.cpp
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the device models of the simulated board, wired
+ * as in main.cpp:
+ *
+ *  Device              | Bus               | Pins
+ *  ---------------------------------------------------------------------------
+ *  TMP102 [2]          | I2C, address 0x48 | sda p28, scl p27
+ *  N5110, PCD8544 [3]  | SPI               | sce p8, rst p9, dc p10, sclk p13
+ *
+ * The TMP102 model returns the temperature of a signal source at the
+ * simulated time of every read (its conversion rate is not modelled):
+ *
+ *  MBED_SIM_TMP102    | file of temperatures (°C), one per line, played
+ *                     | one per read and repeated; if unset, the signal is
+ *                     | 25 + 2･sin(2𝜋･0.5･t) + 0.5･sin(2𝜋･3･t) °C plus
+ *                     | ±1 LSB of uniform noise
+ *
+ * The PCD8544 model keeps the 84x48 display RAM and saves it as a binary
+ * PBM image to MBED_SIM_LCD (if set), after every frame (at most every 100 ms
+ * of real time) and on exit. A frame ends when the data wraps back to 0,0 or
+ * when the address is set back to 0,0 after a partial refresh, and the SPI
+ * bytes per frame are reported on exit.
+ *
+ * Dependencies:
+ *  "mbed.h", ANSI C99
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] Texas Instruments, "TMP102 Low-Power Digital Temperature Sensor,"
+ *      SBOS397F, 2012.
+ *  [3] Philips Semiconductors, "PCD8544 48 × 84 pixels matrix LCD
+ *      controller/driver," Product specification, 1999.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "mbed.h"
+#include <vector>
+
+#define TMP102_ADDRESS 0x48
+
+#define LCD_SCE  p8
+#define LCD_RST  p9
+#define LCD_DC   p10
+#define LCD_SCLK p13
+
+#define LCD_WIDTH  84
+#define LCD_BANKS  6  // rows of 8 pixels
+
+#define LCD_SAVE_INTERVAL 0.1 // s (real time)
+
+
+// TMP102 temperature sensor, registers are addressed by the pointer
+// register, i.e. the first byte of every write transaction
+class TMP102Model : public SimI2CDevice {
+public:
+
+  TMP102Model() : pointer(0), seed(0x2545F491), next(0) {
+    reg[0] = 0;      // temperature
+    reg[1] = 0x60A0; // configuration
+    reg[2] = 0x4B00; // T(low), 75 °C
+    reg[3] = 0x5000; // T(high), 80 °C
+
+    const char *path = getenv("MBED_SIM_TMP102");
+    if (path != NULL) {
+      FILE *fp = fopen(path, "r");
+      float t;
+      if (fp == NULL)
+        fprintf(stderr, "mbed_sim: cannot open %s\n", path);
+      else {
+        while (fscanf(fp, "%f", &t) == 1)
+          samples.push_back(t);
+        fclose(fp);
+      }
+    }
+  }
+
+  int write(const char *data, int length) {
+    if (length > 0)
+      pointer = data[0] & 0x03;
+    for (int i = 1; i < length; i++) {
+      if (pointer == 0)
+        continue; // read-only
+      if (i & 1)
+        reg[pointer] = (reg[pointer] & 0x00FF) | ((data[i] & 0xFF) << 8);
+      else
+        reg[pointer] = (reg[pointer] & 0xFF00) | (data[i] & 0xFF);
+    }
+    return 0;
+  }
+
+  int read(char *data, int length) {
+    if (pointer == 0)
+      reg[0] = convert(temperature());
+    for (int i = 0; i < length; i++)
+      data[i] = (i & 1)? (reg[pointer] & 0xFF) : (reg[pointer] >> 8);
+    return 0;
+  }
+
+private:
+
+  // Signal source (°C)
+  float temperature() {
+    if (!samples.empty()) {
+      float t = samples[next];
+      next = (next + 1) % samples.size();
+      return t;
+    }
+    float t = mbed_sim_time_us() * 1e-6f;
+    return 25 + 2*sinf(2*M_PI*0.5f*t) + 0.5f*sinf(2*M_PI*3*t) +
+           noise()*0.0625f;
+  }
+
+  // Uniform noise in [-1, 1] (xorshift32)
+  float noise() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (int32_t) seed / 2147483648.0f;
+  }
+
+  // 12-bit two's complement temperature, 0.0625 °C per LSB, left aligned
+  static uint16_t convert(float t) {
+    long q = lrintf(t * 16);
+    q = (q > 2047)? 2047 : (q < -2048)? -2048 : q;
+    return (uint16_t) (q << 4);
+  }
+
+  int pointer;
+  uint16_t reg[4];
+  uint32_t seed;
+  std::vector<float> samples;
+  size_t next;
+};
+
+
+// PCD8544 LCD controller of the N5110 display, bytes are commands while DC
+// is low and display data while DC is high
+class PCD8544Model : public SimSPIDevice {
+public:
+
+  PCD8544Model() : x(0), y(0), vertical(0), extended(0), mode(0),
+                   changed(0), frames(0), bytes(0), total(0), max(0),
+                   saved(0) {
+    memset(ram, 0, sizeof(ram));
+    path = getenv("MBED_SIM_LCD");
+  }
+
+  int write(int value, int bits) {
+    if (mbed_sim_pin_read(LCD_SCE))
+      return -1; // not selected
+    if (!mbed_sim_pin_read(LCD_RST)) {
+      x = y = vertical = extended = mode = 0;
+      return 0;
+    }
+    bytes++;
+    if (mbed_sim_pin_read(LCD_DC))
+      data(value);
+    else
+      command(value);
+    return 0;
+  }
+
+  // Print the SPI bytes per frame, commands included
+  void report() {
+    if (frames > 0)
+      fprintf(stderr, "lcd: %lu frames, %.1f SPI bytes/frame (max %lu)\n",
+              frames, (double) total / frames, max);
+  }
+
+  // Save the display RAM as a PBM image, displayed as in the display mode
+  void save() {
+    if (path == NULL)
+      return;
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL)
+      return;
+    fprintf(fp, "P4\n%d %d\n", LCD_WIDTH, LCD_BANKS*8);
+    for (int row = 0; row < LCD_BANKS*8; row++) {
+      unsigned char line[(LCD_WIDTH + 7) / 8] = { 0 };
+      for (int col = 0; col < LCD_WIDTH; col++)
+        if (pixel(col, row))
+          line[col >> 3] |= 0x80 >> (col & 7);
+      fwrite(line, 1, sizeof(line), fp);
+    }
+    fclose(fp);
+    rename(tmp, path);
+  }
+
+private:
+
+  void command(int c) {
+    if (c & 0x80) {        // set X address (basic), Vop (extended)
+      if (!extended)
+        x = (c & 0x7F) % LCD_WIDTH;
+    } else if (c & 0x40) { // set Y address (basic)
+      if (!extended) {
+        y = (c & 0x07) % LCD_BANKS;
+        if (x == 0 && y == 0 && changed) // back to 0,0 after a partial refresh
+          frame();
+      }
+    } else if (c & 0x20) { // function set: PD, V, H
+      vertical = (c >> 1) & 1;
+      extended = c & 1;
+    } else if ((c & 0x08) && !extended) { // display control: D, E
+      mode = ((c >> 1) & 2) | (c & 1);
+    } // the other extended commands (bias, temperature) do not affect the RAM
+  }
+
+  void data(int d) {
+    ram[y][x] = d;
+    changed = 1;
+    if (vertical) {
+      if (++y == LCD_BANKS) {
+        y = 0;
+        x = (x + 1) % LCD_WIDTH;
+      }
+    } else if (++x == LCD_WIDTH) {
+      x = 0;
+      y = (y + 1) % LCD_BANKS;
+    }
+    if (x == 0 && y == 0) // end of frame
+      frame();
+  }
+
+  // Frame written, saved at most every LCD_SAVE_INTERVAL
+  void frame() {
+    frames++;
+    changed = 0;
+    total += bytes;
+    if (bytes > max)
+      max = bytes;
+    bytes = 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double now = ts.tv_sec + ts.tv_nsec*1e-9;
+    if (frames == 1 || now - saved >= LCD_SAVE_INTERVAL) {
+      save();
+      saved = now;
+    }
+  }
+
+  // Pixel as displayed: blank (0), normal (2), all on (1) or inverse (3)
+  int pixel(int col, int row) {
+    int on = (ram[row >> 3][col] >> (row & 7)) & 1;
+    switch (mode) {
+    case 2: return on;
+    case 3: return !on;
+    case 1: return 1;
+    default: return 0;
+    }
+  }
+
+  unsigned char ram[LCD_BANKS][LCD_WIDTH];
+  int x, y;
+  int vertical, extended, mode;
+  int changed; // RAM written since the last frame
+  const char *path;
+  unsigned long frames;
+  unsigned long bytes, total, max; // SPI bytes of the frame, of all, per frame
+  double saved; // real time of the last save (s)
+};
+
+
+// Board, attaches the device models before main()
+static struct Board {
+
+  TMP102Model tmp102;
+  PCD8544Model lcd;
+
+  Board() {
+    mbed_sim_i2c_attach(TMP102_ADDRESS, &tmp102);
+    mbed_sim_spi_attach(LCD_SCLK, &lcd);
+    mbed_sim_atexit(exit_lcd);
+  }
+
+  static void exit_lcd(void);
+} board;
+
+
+void Board::exit_lcd(void) {
+
+  board.lcd.report();
+  board.lcd.save();
+}
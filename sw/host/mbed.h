@@ -0,0 +1,595 @@
+/* mbed.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the simulated mbed HAL of the host build. It is
+ * included instead of the mbed SDK header (mbed/mbed.h), so that dsp/,
+ * TempScope/, N5110/, TMP102/ and main.cpp compile unchanged on a PC.
+ *
+ * The classes have the names and signatures of the mbed SDK [2] for the
+ * subset used by the application and the drivers:
+ *
+ *  Class           | Backed by
+ *  ---------------------------------------------------------------------------
+ *  DigitalIn/Out   | pin table of the simulator (see mbed_sim.h)
+ *  BusOut, PwmOut  | pin table of the simulator
+ *  I2C             | device models attached by address (see board_sim.cpp)
+ *  SPI             | device models attached by clock pin
+ *  Serial          | stdout (TX), file or FIFO MBED_SIM_SERIAL (RX)
+ *  Ticker, Timer   | simulated clock, one pthread per attached Ticker
+ *  LocalFileSystem | directory MBED_SIM_LOCAL (default ./local)
+ *
+ * The simulated clock runs in real time, scaled by MBED_SIM_SPEED, or, if
+ * MBED_SIM_SPEED is 0, as a virtual clock that only advances when the
+ * program waits or transfers data over a bus (see mbed_sim.h).
+ *
+ * Dependencies:
+ *  "mbed_sim.h", ANSI C99, POSIX.1-2001
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] ARM Ltd., "mbed Microcontroller Library," headers of sw/mbed, 2014.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_HOST_MBED_H_
+#define __CPP98_HOST_MBED_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+// Pins of the mbed LPC1768 board
+typedef enum {
+  p5 = 5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19,
+  p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30,
+  LED1, LED2, LED3, LED4,
+  USBTX, USBRX,
+
+  // Not connected
+  NC = (int) 0xFFFFFFFF
+} PinName;
+
+// Pin modes
+typedef enum {
+  PullUp = 0,
+  PullDown = 3,
+  PullNone = 2,
+  OpenDrain = 4,
+  PullDefault = PullDown
+} PinMode;
+
+#include "mbed_sim.h"
+
+namespace mbed {
+
+typedef uint32_t timestamp_t; // us
+
+typedef void (*pvoidf_t)(void);
+
+
+// Static or member function callback (Ticker, Serial)
+class FunctionPointer {
+public:
+
+  FunctionPointer(void (*function)(void) = 0) {
+    attach(function);
+  }
+
+  template<typename T>
+  FunctionPointer(T *object, void (T::*member)(void)) {
+    attach(object, member);
+  }
+
+  void attach(void (*function)(void) = 0) {
+    _function = function;
+    _object = 0;
+  }
+
+  template<typename T>
+  void attach(T *object, void (T::*member)(void)) {
+    _object = static_cast<void *>(object);
+    memcpy(_member, (char *) &member, sizeof(member));
+    _membercaller = &FunctionPointer::membercaller<T>;
+    _function = 0;
+  }
+
+  void call() {
+    if (_function != 0)
+      _function();
+    else if (_object != 0)
+      _membercaller(_object, _member);
+  }
+
+  pvoidf_t get_function() const {
+    return (pvoidf_t) _function;
+  }
+
+private:
+
+  template<typename T>
+  static void membercaller(void *object, char *member) {
+    T *o = static_cast<T *>(object);
+    void (T::*m)(void);
+    memcpy((char *) &m, member, sizeof(m));
+    (o->*m)();
+  }
+
+  void (*_function)(void);             // static function, 0 if none
+  void *_object;                       // object of member, 0 if none
+  char _member[16];                    // raw member function pointer
+  void (*_membercaller)(void*, char*); // calls _member on _object
+};
+
+
+// Digital output pin
+class DigitalOut {
+public:
+
+  DigitalOut(PinName pin) : _pin(pin) {
+    mbed_sim_pin_write(_pin, 0);
+  }
+
+  DigitalOut(PinName pin, int value) : _pin(pin) {
+    mbed_sim_pin_write(_pin, value);
+  }
+
+  void write(int value) {
+    mbed_sim_pin_write(_pin, value);
+  }
+
+  int read() {
+    return mbed_sim_pin_read(_pin);
+  }
+
+  DigitalOut &operator= (int value) {
+    write(value);
+    return *this;
+  }
+
+  DigitalOut &operator= (DigitalOut &rhs) {
+    write(rhs.read());
+    return *this;
+  }
+
+  operator int() {
+    return read();
+  }
+
+private:
+  PinName _pin;
+};
+
+
+// Digital input pin, the level is set by the pull resistor, MBED_SIM_PINS or
+// mbed_sim_pin_write()
+class DigitalIn {
+public:
+
+  DigitalIn(PinName pin) : _pin(pin) {
+    mode(PullDefault);
+  }
+
+  DigitalIn(PinName pin, PinMode pull) : _pin(pin) {
+    mode(pull);
+  }
+
+  int read() {
+    return mbed_sim_pin_read(_pin);
+  }
+
+  void mode(PinMode pull) {
+    mbed_sim_pin_pull(_pin, pull == PullUp);
+  }
+
+  operator int() {
+    return read();
+  }
+
+private:
+  PinName _pin;
+};
+
+
+// Bus of up to 16 digital output pins, p0 is the least significant bit
+class BusOut {
+public:
+
+  BusOut(PinName p0, PinName p1 = NC, PinName p2 = NC, PinName p3 = NC,
+         PinName p4 = NC, PinName p5 = NC, PinName p6 = NC, PinName p7 = NC,
+         PinName p8 = NC, PinName p9 = NC, PinName p10 = NC, PinName p11 = NC,
+         PinName p12 = NC, PinName p13 = NC, PinName p14 = NC,
+         PinName p15 = NC) {
+    PinName pins[16] = { p0, p1, p2, p3, p4, p5, p6, p7,
+                         p8, p9, p10, p11, p12, p13, p14, p15 };
+    memcpy(_pin, pins, sizeof(_pin));
+    write(0);
+  }
+
+  BusOut(PinName pins[16]) {
+    memcpy(_pin, pins, sizeof(_pin));
+    write(0);
+  }
+
+  void write(int value) {
+    for (int i = 0; i < 16; i++)
+      mbed_sim_pin_write(_pin[i], (value >> i) & 1);
+  }
+
+  int read() {
+    int value = 0;
+    for (int i = 0; i < 16; i++)
+      if (_pin[i] != NC)
+        value |= mbed_sim_pin_read(_pin[i]) << i;
+    return value;
+  }
+
+  BusOut &operator= (int value) {
+    write(value);
+    return *this;
+  }
+
+  BusOut &operator= (BusOut &rhs) {
+    write(rhs.read());
+    return *this;
+  }
+
+  operator int() {
+    return read();
+  }
+
+private:
+  PinName _pin[16];
+};
+
+
+// PWM output pin, the pin reads 1 while the duty cycle is non-zero
+class PwmOut {
+public:
+
+  PwmOut(PinName pin) : _pin(pin), _period_us(20000), _duty(0) {
+    mbed_sim_pin_write(_pin, 0);
+  }
+
+  void write(float value) {
+    _duty = (value < 0)? 0 : (value > 1)? 1 : value;
+    mbed_sim_pin_write(_pin, _duty > 0);
+  }
+
+  float read() {
+    return _duty;
+  }
+
+  void period(float seconds) { period_us(seconds * 1000000.0f); }
+  void period_ms(int ms) { period_us(ms * 1000); }
+  void period_us(int us) { _period_us = (us > 0)? us : 1; }
+
+  void pulsewidth(float seconds) { pulsewidth_us(seconds * 1000000.0f); }
+  void pulsewidth_ms(int ms) { pulsewidth_us(ms * 1000); }
+  void pulsewidth_us(int us) { write((float) us / _period_us); }
+
+  PwmOut &operator= (float value) {
+    write(value);
+    return *this;
+  }
+
+  PwmOut &operator= (PwmOut &rhs) {
+    write(rhs.read());
+    return *this;
+  }
+
+  operator float() {
+    return read();
+  }
+
+private:
+  PinName _pin;
+  int _period_us;
+  float _duty;
+};
+
+
+// SPI master, every byte is delivered to the device models attached to the
+// clock pin (the models decode their own chip select)
+class SPI {
+public:
+
+  SPI(PinName mosi, PinName miso, PinName sclk, PinName _unused = NC)
+    : _sclk(sclk), _bits(8), _hz(1000000) {
+  }
+
+  void format(int bits, int mode = 0) {
+    _bits = bits;
+  }
+
+  void frequency(int hz = 1000000) {
+    _hz = hz;
+  }
+
+  virtual int write(int value) {
+    return mbed_sim_spi_write(_sclk, value, _bits, _hz);
+  }
+
+  virtual ~SPI() {
+  }
+
+private:
+  PinName _sclk;
+  int _bits;
+  int _hz;
+};
+
+
+// I2C master, the transfers are delivered to the device model of the 7-bit
+// address (bit 0 of the 8-bit address is ignored), returns 0 on ACK
+class I2C {
+public:
+
+  enum RxStatus {
+    NoData,
+    MasterGeneralCall,
+    MasterWrite,
+    MasterRead
+  };
+
+  enum Acknowledge {
+    NoACK = 0,
+    ACK   = 1
+  };
+
+  I2C(PinName sda, PinName scl) : _hz(100000), _address(-1) {
+  }
+
+  void frequency(int hz) {
+    _hz = hz;
+  }
+
+  int read(int address, char *data, int length, bool repeated = false) {
+    return mbed_sim_i2c_read(address >> 1, data, length, _hz);
+  }
+
+  int write(int address, const char *data, int length, bool repeated = false) {
+    return mbed_sim_i2c_write(address >> 1, data, length, _hz);
+  }
+
+  // Byte transfers of a transaction started by start(), the first byte
+  // written is the address
+  int read(int ack) {
+    char data = (char) 0xFF;
+    mbed_sim_i2c_read(_address, &data, 1, _hz);
+    return (unsigned char) data;
+  }
+
+  int write(int data) {
+    if (_address < 0) {
+      _address = (data & 0xFF) >> 1;
+      return !mbed_sim_i2c_present(_address);
+    }
+    char c = (char) data;
+    return !mbed_sim_i2c_write(_address, &c, 1, _hz);
+  }
+
+  void start(void) {
+    _address = -1;
+  }
+
+  void stop(void) {
+    _address = -1;
+  }
+
+private:
+  int _hz;
+  int _address; // 7-bit address of the byte transfers, -1 after start()
+};
+
+
+// Serial port, TX is written to stdout and RX is read from MBED_SIM_SERIAL
+class Serial {
+public:
+
+  enum Parity {
+    None = 0,
+    Odd,
+    Even,
+    Forced1,
+    Forced0
+  };
+
+  enum IrqType {
+    RxIrq = 0,
+    TxIrq
+  };
+
+  Serial(PinName tx, PinName rx, const char *name = NULL) {
+  }
+
+  void baud(int baudrate) {
+  }
+
+  void format(int bits = 8, Parity parity = None, int stop_bits = 1) {
+  }
+
+  int readable() {
+    return mbed_sim_serial_readable();
+  }
+
+  int writeable() {
+    return 1;
+  }
+
+  // RX callbacks are called by the RX thread of the simulator while data is
+  // available, TX callbacks are never called
+  void attach(void (*fptr)(void), IrqType type = RxIrq) {
+    if (type == RxIrq) {
+      _rx.attach(fptr);
+      mbed_sim_serial_attach(fptr? &_rx : NULL);
+    }
+  }
+
+  template<typename T>
+  void attach(T *tptr, void (T::*mptr)(void), IrqType type = RxIrq) {
+    if (type == RxIrq && tptr != NULL && mptr != NULL) {
+      _rx.attach(tptr, mptr);
+      mbed_sim_serial_attach(&_rx);
+    }
+  }
+
+  int putc(int c) {
+    return fputc(c, stdout);
+  }
+
+  int puts(const char *str) {
+    return fputs(str, stdout);
+  }
+
+  int getc() {
+    return mbed_sim_serial_getc();
+  }
+
+  int printf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int r = vfprintf(stdout, format, args);
+    va_end(args);
+    return r;
+  }
+
+  virtual ~Serial() {
+    mbed_sim_serial_detach(&_rx);
+  }
+
+private:
+  FunctionPointer _rx;
+};
+
+
+// Periodic callback, called by its own thread of the simulator
+class Ticker {
+public:
+
+  Ticker() : _ticker(NULL) {
+  }
+
+  void attach(void (*fptr)(void), float t) {
+    attach_us(fptr, t * 1000000.0f);
+  }
+
+  template<typename T>
+  void attach(T *tptr, void (T::*mptr)(void), float t) {
+    attach_us(tptr, mptr, t * 1000000.0f);
+  }
+
+  void attach_us(void (*fptr)(void), timestamp_t t) {
+    detach();
+    _function.attach(fptr);
+    _ticker = mbed_sim_ticker_start(&_function, t);
+  }
+
+  template<typename T>
+  void attach_us(T *tptr, void (T::*mptr)(void), timestamp_t t) {
+    detach();
+    _function.attach(tptr, mptr);
+    _ticker = mbed_sim_ticker_start(&_function, t);
+  }
+
+  void detach() {
+    if (_ticker != NULL)
+      mbed_sim_ticker_stop(_ticker);
+    _ticker = NULL;
+  }
+
+  virtual ~Ticker() {
+    detach();
+  }
+
+private:
+  FunctionPointer _function;
+  mbed_sim_ticker_t *_ticker;
+};
+
+
+// Stopwatch of the simulated clock
+class Timer {
+public:
+
+  Timer() : _running(0), _start(0), _time(0) {
+  }
+
+  void start() {
+    if (!_running) {
+      _start = mbed_sim_time_us();
+      _running = 1;
+    }
+  }
+
+  void stop() {
+    _time += slicetime();
+    _running = 0;
+  }
+
+  void reset() {
+    _start = mbed_sim_time_us();
+    _time = 0;
+  }
+
+  float read() {
+    return read_us() / 1000000.0f;
+  }
+
+  int read_ms() {
+    return read_us() / 1000;
+  }
+
+  int read_us() {
+    return (int) (_time + slicetime());
+  }
+
+  operator float() {
+    return read();
+  }
+
+private:
+
+  uint64_t slicetime() {
+    return _running? mbed_sim_time_us() - _start : 0;
+  }
+
+  int _running;
+  uint64_t _start; // us
+  uint64_t _time;  // us
+};
+
+
+// Local filesystem, "/<name>/<file>" is opened as <MBED_SIM_LOCAL>/<file>
+class LocalFileSystem {
+public:
+
+  LocalFileSystem(const char *n) {
+    mbed_sim_mount(n);
+  }
+};
+
+} // namespace mbed
+
+using namespace mbed;
+
+
+// Wait functions of the simulated clock
+inline void wait(float s) { mbed_sim_sleep_us((uint64_t) (s * 1000000.0f)); }
+inline void wait_ms(int ms) { mbed_sim_sleep_us((uint64_t) ms * 1000); }
+inline void wait_us(int us) { mbed_sim_sleep_us(us); }
+
+// Real time clock, time() returns t plus the simulated time since the call
+inline void set_time(time_t t) { mbed_sim_set_time(t); }
+
+
+#endif // __CPP98_HOST_MBED_H_
@@ -0,0 +1,768 @@
+/* mbed_sim.cpp
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the simulator behind the
+ * host HAL: the simulated clock, the pin table, the I2C and SPI buses, the
+ * DMA to the SPI bus, the serial port RX, the tickers, the local filesystem and the exit of the
+ * simulation.
+ *
+ * The simulator is initialised on first use, from whichever static
+ * constructor or thread calls it first.
+ *
+ * Dependencies:
+ *  "mbed.h", ANSI C99, POSIX.1-2001
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "mbed.h"
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+
+// Size of the pin table (PinName values)
+#define SIM_PINS     64
+
+// Maximum number of SPI device models, mounts and exit functions
+#define SIM_SPI_MAX  8
+#define SIM_MOUNTS   4
+#define SIM_ATEXIT   8
+
+// Functions wrapped at link time (-Wl,--wrap=fopen,--wrap=time)
+extern "C" FILE *__real_fopen(const char *path, const char *mode);
+extern "C" time_t __real_time(time_t *t);
+
+// Simulator state
+static struct {
+  double speed;            // x real time, 0 = virtual clock
+  struct timespec start;   // monotonic time of the start
+  volatile uint64_t clock; // virtual clock (ns)
+  volatile int tickers;    // running tickers
+  pthread_mutex_t clock_mutex;
+  pthread_cond_t clock_cond; // broadcast when a ticker advances the clock
+  uint64_t duration;       // exit after this simulated time (us), 0 = never
+
+  time_t rtc;              // real time clock set by set_time()
+  uint64_t rtc_us;         // simulated time of set_time() (us)
+
+  volatile int pin[SIM_PINS];
+  char forced[SIM_PINS];   // level set by MBED_SIM_PINS
+
+  SimI2CDevice *i2c[128];
+  pthread_mutex_t i2c_mutex;
+
+  PinName spi_sclk[SIM_SPI_MAX];
+  SimSPIDevice *spi[SIM_SPI_MAX];
+  int spi_devices;
+  pthread_mutex_t spi_mutex;
+
+  pthread_mutex_t dma_mutex; // DMA channel to the SPI master
+  pthread_cond_t dma_cond;   // signalled when a transfer starts
+  int dma_thread;            // 1 once the DMA thread is running
+  int dma_busy;
+  PinName dma_sclk;
+  const unsigned char *dma_data;
+  int dma_length;
+  int dma_hz;
+  mbed::FunctionPointer *dma_done;
+
+  const char *serial;      // RX source
+  int serial_fd;
+  pthread_mutex_t serial_mutex;
+  mbed::FunctionPointer *volatile serial_rx;
+  int serial_thread;       // 1 once the RX thread is running
+
+  const char *local;       // directory of the LocalFileSystem
+  char mount[SIM_MOUNTS][16];
+  int mounts;
+
+  void (*atexit[SIM_ATEXIT])(void);
+  int atexits;
+  int exiting;
+  pthread_mutex_t exit_mutex;
+
+  // statistics
+  volatile unsigned long i2c_transfers;
+  volatile unsigned long spi_bytes;
+  volatile unsigned long ticks;
+} sim;
+
+static pthread_once_t sim_once = PTHREAD_ONCE_INIT;
+
+// 1 in the ticker threads
+static __thread int in_ticker = 0;
+
+
+// Ticker thread
+struct mbed_sim_ticker_t {
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  mbed::FunctionPointer *fn;
+  uint64_t period;         // us
+  int active;
+  int orphan;              // stopped by its own callback, frees itself
+};
+
+
+static double elapsed_s(void) {
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - sim.start.tv_sec) +
+         (now.tv_nsec - sim.start.tv_nsec) * 1e-9;
+}
+
+
+// Monotonic time of the simulated time t (us)
+static struct timespec realtime_of(uint64_t t) {
+
+  double s = t / (sim.speed * 1e6);
+  struct timespec ts = sim.start;
+  ts.tv_sec += (time_t) s;
+  ts.tv_nsec += (long) ((s - (time_t) s) * 1e9);
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  return ts;
+}
+
+
+// Advance the virtual clock to t (ns), if it is behind, and wake up the
+// threads that wait for it
+static void clock_advance_to(uint64_t t) {
+
+  uint64_t now = sim.clock;
+  while (now < t && !__sync_bool_compare_and_swap(&sim.clock, now, t))
+    now = sim.clock;
+  pthread_mutex_lock(&sim.clock_mutex);
+  pthread_cond_broadcast(&sim.clock_cond);
+  pthread_mutex_unlock(&sim.clock_mutex);
+}
+
+
+static int pin_index(PinName pin) {
+
+  return (pin >= 0 && pin < SIM_PINS)? pin : -1;
+}
+
+
+static PinName pin_by_name(const char *name) {
+
+  static const struct { const char *name; PinName pin; } pins[] = {
+    { "LED1", LED1 }, { "LED2", LED2 }, { "LED3", LED3 }, { "LED4", LED4 },
+    { "USBTX", USBTX }, { "USBRX", USBRX }
+  };
+  if (name[0] == 'p') {
+    int n = atoi(name + 1);
+    return (n >= p5 && n <= p30)? (PinName) n : NC;
+  }
+  for (unsigned i = 0; i < sizeof(pins) / sizeof(pins[0]); i++)
+    if (!strcmp(name, pins[i].name))
+      return pins[i].pin;
+  return NC;
+}
+
+
+// MBED_SIM_PINS="p18=1,p16=0"
+static void parse_pins(const char *s) {
+
+  char buf[256];
+  strncpy(buf, s, sizeof(buf) - 1);
+  buf[sizeof(buf) - 1] = 0;
+  for (char *tok = strtok(buf, ",; "); tok != NULL; tok = strtok(NULL, ",; ")) {
+    char *eq = strchr(tok, '=');
+    if (eq == NULL)
+      continue;
+    *eq = 0;
+    int i = pin_index(pin_by_name(tok));
+    if (i < 0) {
+      fprintf(stderr, "mbed_sim: unknown pin %s\n", tok);
+      continue;
+    }
+    sim.pin[i] = atoi(eq + 1) != 0;
+    sim.forced[i] = 1;
+  }
+}
+
+
+static void run_atexit(void) {
+
+  pthread_mutex_lock(&sim.exit_mutex);
+  int first = !sim.exiting;
+  sim.exiting = 1;
+  pthread_mutex_unlock(&sim.exit_mutex);
+  if (!first)
+    return;
+
+  for (int i = sim.atexits - 1; i >= 0; i--)
+    sim.atexit[i]();
+
+  fprintf(stderr, "mbed_sim: %.3f s simulated in %.3f s, %lu I2C transfers, "
+          "%lu SPI bytes, %lu ticks\n", mbed_sim_time_us() * 1e-6,
+          elapsed_s(), sim.i2c_transfers, sim.spi_bytes, sim.ticks);
+}
+
+
+// Exit after MBED_SIM_DURATION simulated seconds
+static void *watchdog_thread(void *arg) {
+
+  for (;;) {
+    uint64_t now = mbed_sim_time_us();
+    if (now >= sim.duration)
+      mbed_sim_exit(0);
+    if (sim.speed > 0) {
+      struct timespec ts = realtime_of(sim.duration);
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    } else {
+      usleep(1000);
+    }
+  }
+  return NULL;
+}
+
+
+static void sim_init(void) {
+
+  clock_gettime(CLOCK_MONOTONIC, &sim.start);
+
+  const char *speed = getenv("MBED_SIM_SPEED");
+  sim.speed = (speed != NULL)? atof(speed) : 1;
+  if (sim.speed < 0)
+    sim.speed = 1;
+
+  sim.rtc = __real_time(NULL);
+  sim.rtc_us = 0;
+
+  const char *pins = getenv("MBED_SIM_PINS");
+  if (pins != NULL)
+    parse_pins(pins);
+
+  pthread_mutex_init(&sim.clock_mutex, NULL);
+  pthread_cond_init(&sim.clock_cond, NULL);
+  pthread_mutex_init(&sim.i2c_mutex, NULL);
+  pthread_mutex_init(&sim.spi_mutex, NULL);
+  pthread_mutex_init(&sim.dma_mutex, NULL);
+  pthread_cond_init(&sim.dma_cond, NULL);
+  pthread_mutex_init(&sim.serial_mutex, NULL);
+  pthread_mutex_init(&sim.exit_mutex, NULL);
+
+  sim.serial = getenv("MBED_SIM_SERIAL");
+  sim.serial_fd = -1;
+
+  sim.local = getenv("MBED_SIM_LOCAL");
+  if (sim.local == NULL)
+    sim.local = "local";
+
+  atexit(run_atexit);
+
+  const char *duration = getenv("MBED_SIM_DURATION");
+  if (duration != NULL && atof(duration) > 0) {
+    sim.duration = (uint64_t) (atof(duration) * 1e6);
+    pthread_t thread;
+    pthread_create(&thread, NULL, watchdog_thread, NULL);
+    pthread_detach(thread);
+  }
+}
+
+
+static inline void sim_init_once(void) {
+
+  pthread_once(&sim_once, sim_init);
+}
+
+
+// --- Clock ---
+
+uint64_t mbed_sim_time_us(void) {
+
+  sim_init_once();
+  if (sim.speed == 0)
+    return sim.clock / 1000;
+  return (uint64_t) (elapsed_s() * sim.speed * 1e6);
+}
+
+
+void mbed_sim_sleep_us(uint64_t us) {
+
+  sim_init_once();
+  if (sim.speed == 0) {
+    if (us == 0)
+      return; // a wait of 0 does not give up the processor
+    uint64_t t = sim.clock + us * 1000;
+    pthread_mutex_lock(&sim.clock_mutex);
+    while (sim.clock < t && sim.tickers > 0 && !in_ticker)
+      pthread_cond_wait(&sim.clock_cond, &sim.clock_mutex);
+    pthread_mutex_unlock(&sim.clock_mutex);
+    clock_advance_to(t);
+    sched_yield();
+    return;
+  }
+  double s = us / (sim.speed * 1e6);
+  struct timespec ts;
+  ts.tv_sec = (time_t) s;
+  ts.tv_nsec = (long) ((s - ts.tv_sec) * 1e9);
+  while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    ;
+}
+
+
+void mbed_sim_busy_ns(uint64_t ns) {
+
+  if (sim.speed == 0)
+    __sync_fetch_and_add(&sim.clock, ns);
+}
+
+
+void mbed_sim_set_time(time_t t) {
+
+  sim_init_once();
+  sim.rtc_us = mbed_sim_time_us();
+  sim.rtc = t;
+}
+
+
+extern "C" time_t __wrap_time(time_t *t) {
+
+  sim_init_once();
+  time_t now = sim.rtc + (time_t) ((mbed_sim_time_us() - sim.rtc_us) / 1000000);
+  if (t != NULL)
+    *t = now;
+  return now;
+}
+
+
+// --- Pins ---
+
+int mbed_sim_pin_read(PinName pin) {
+
+  int i = pin_index(pin);
+  return (i < 0)? 0 : sim.pin[i];
+}
+
+
+void mbed_sim_pin_write(PinName pin, int value) {
+
+  int i = pin_index(pin);
+  if (i >= 0)
+    sim.pin[i] = value != 0;
+}
+
+
+void mbed_sim_pin_pull(PinName pin, int value) {
+
+  sim_init_once();
+  int i = pin_index(pin);
+  if (i >= 0 && !sim.forced[i])
+    sim.pin[i] = value != 0;
+}
+
+
+// --- I2C ---
+
+void mbed_sim_i2c_attach(int address, SimI2CDevice *device) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.i2c_mutex);
+  sim.i2c[address & 0x7F] = device;
+  pthread_mutex_unlock(&sim.i2c_mutex);
+}
+
+
+int mbed_sim_i2c_present(int address) {
+
+  return address >= 0 && sim.i2c[address & 0x7F] != NULL;
+}
+
+
+// Duration of a transaction of length bytes, plus the address byte (9 clock
+// cycles per byte with the ACK, and start and stop conditions)
+static uint64_t i2c_ns(int length, int hz) {
+
+  return (uint64_t) ((length + 1)*9 + 2) * 1000000000ULL / hz;
+}
+
+
+int mbed_sim_i2c_read(int address, char *data, int length, int hz) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.i2c_mutex);
+  SimI2CDevice *device = sim.i2c[address & 0x7F];
+  int nack = (device != NULL)? device->read(data, length) : 1;
+  sim.i2c_transfers++;
+  pthread_mutex_unlock(&sim.i2c_mutex);
+  mbed_sim_busy_ns(i2c_ns((device != NULL)? length : 0, hz));
+  return nack;
+}
+
+
+int mbed_sim_i2c_write(int address, const char *data, int length, int hz) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.i2c_mutex);
+  SimI2CDevice *device = sim.i2c[address & 0x7F];
+  int nack = (device != NULL)? device->write(data, length) : 1;
+  sim.i2c_transfers++;
+  pthread_mutex_unlock(&sim.i2c_mutex);
+  mbed_sim_busy_ns(i2c_ns((device != NULL)? length : 0, hz));
+  return nack;
+}
+
+
+// --- SPI ---
+
+void mbed_sim_spi_attach(PinName sclk, SimSPIDevice *device) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.spi_mutex);
+  if (sim.spi_devices < SIM_SPI_MAX) {
+    sim.spi_sclk[sim.spi_devices] = sclk;
+    sim.spi[sim.spi_devices++] = device;
+  }
+  pthread_mutex_unlock(&sim.spi_mutex);
+}
+
+
+int mbed_sim_spi_write(PinName sclk, int value, int bits, int hz) {
+
+  sim_init_once();
+  int miso = -1;
+  pthread_mutex_lock(&sim.spi_mutex);
+  for (int i = 0; i < sim.spi_devices; i++)
+    if (sim.spi_sclk[i] == sclk) {
+      int r = sim.spi[i]->write(value, bits);
+      miso = (miso < 0)? r : miso;
+    }
+  sim.spi_bytes++;
+  pthread_mutex_unlock(&sim.spi_mutex);
+  mbed_sim_busy_ns((uint64_t) bits * 1000000000ULL / hz);
+  return (miso < 0)? 0xFF : miso;
+}
+
+
+// DMA thread, writes the bytes of a transfer while the other threads run
+static void *dma_thread(void *arg) {
+
+  pthread_mutex_lock(&sim.dma_mutex);
+  while (true) {
+    while (!sim.dma_busy)
+      pthread_cond_wait(&sim.dma_cond, &sim.dma_mutex);
+    PinName sclk = sim.dma_sclk;
+    const unsigned char *data = sim.dma_data;
+    int length = sim.dma_length;
+    int hz = sim.dma_hz;
+    mbed::FunctionPointer *done = sim.dma_done;
+    pthread_mutex_unlock(&sim.dma_mutex);
+
+    for (int i = 0; i < length; i++)
+      mbed_sim_spi_write(sclk, data[i], 8, hz);
+    if (sim.speed > 0) // the transfer takes its time at the bus frequency
+      mbed_sim_sleep_us((uint64_t) length * 8 * 1000000 / hz);
+
+    pthread_mutex_lock(&sim.dma_mutex);
+    sim.dma_busy = 0; // terminal count, the callback may start the next one
+    pthread_mutex_unlock(&sim.dma_mutex);
+    if (done != NULL)
+      done->call();
+    pthread_mutex_lock(&sim.dma_mutex);
+  }
+  return NULL;
+}
+
+
+int mbed_sim_spi_dma(PinName sclk, const unsigned char *data, int length,
+                     int hz, mbed::FunctionPointer *done) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.dma_mutex);
+  if (sim.dma_busy) {
+    pthread_mutex_unlock(&sim.dma_mutex);
+    return -1;
+  }
+  if (!sim.dma_thread) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, dma_thread, NULL);
+    pthread_detach(thread);
+    sim.dma_thread = 1;
+  }
+  sim.dma_sclk = sclk;
+  sim.dma_data = data;
+  sim.dma_length = length;
+  sim.dma_hz = (hz > 0)? hz : 1000000;
+  sim.dma_done = done;
+  sim.dma_busy = 1;
+  pthread_cond_signal(&sim.dma_cond);
+  pthread_mutex_unlock(&sim.dma_mutex);
+  return 0;
+}
+
+
+// --- Serial ---
+
+// Open the RX source, blocks until a FIFO has a writer
+static int serial_open(void) {
+
+  if (sim.serial_fd < 0 && sim.serial != NULL) {
+    sim.serial_fd = open(sim.serial, O_RDONLY);
+    if (sim.serial_fd < 0)
+      fprintf(stderr, "mbed_sim: cannot open %s\n", sim.serial);
+  }
+  return sim.serial_fd;
+}
+
+
+// Bytes that read() returns without blocking (a regular file polls readable
+// at its end, so its remaining bytes are counted instead)
+static int serial_pending(int fd) {
+
+  int n = 0;
+  if (fd < 0 || ioctl(fd, FIONREAD, &n) < 0)
+    return 0;
+  return n;
+}
+
+
+int mbed_sim_serial_readable(void) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.serial_mutex);
+  int readable = serial_pending(sim.serial_fd) > 0;
+  pthread_mutex_unlock(&sim.serial_mutex);
+  return readable;
+}
+
+
+// Blocks until a byte is available, an exhausted FIFO is reopened for the
+// next writer and an exhausted file blocks forever (no more data arrives)
+int mbed_sim_serial_getc(void) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.serial_mutex);
+  for (;;) {
+    int fd = serial_open();
+    unsigned char c;
+    ssize_t n = (fd >= 0)? read(fd, &c, 1) : 0;
+    if (n == 1) {
+      pthread_mutex_unlock(&sim.serial_mutex);
+      return c;
+    }
+    if (n < 0 && errno == EINTR)
+      continue;
+
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode)) {
+      close(fd);
+      sim.serial_fd = -1;
+      continue;
+    }
+    pthread_mutex_unlock(&sim.serial_mutex);
+    for (;;)
+      pause();
+  }
+}
+
+
+// Calls the RX callback while data is available, reopens a FIFO that has no
+// writer and stops at the end of a regular file
+static void *serial_thread(void *arg) {
+
+  for (;;) {
+    pthread_mutex_lock(&sim.serial_mutex);
+    int fd = serial_open();
+    pthread_mutex_unlock(&sim.serial_mutex);
+    if (fd < 0)
+      break;
+    struct pollfd p = { fd, POLLIN, 0 };
+    if (poll(&p, 1, -1) < 0 && errno != EINTR)
+      break;
+
+    if (serial_pending(fd) == 0) {
+      struct stat st;
+      if (fstat(fd, &st) != 0 || !S_ISFIFO(st.st_mode))
+        break; // end of file
+      if (p.revents & POLLHUP) {
+        pthread_mutex_lock(&sim.serial_mutex);
+        if (sim.serial_fd == fd && serial_pending(fd) == 0) {
+          close(fd);
+          sim.serial_fd = -1;
+        }
+        pthread_mutex_unlock(&sim.serial_mutex);
+      }
+      continue;
+    }
+
+    mbed::FunctionPointer *rx = sim.serial_rx;
+    if (rx != NULL)
+      rx->call();
+    else
+      usleep(1000);
+  }
+  return NULL;
+}
+
+
+void mbed_sim_serial_attach(mbed::FunctionPointer *rx) {
+
+  sim_init_once();
+  sim.serial_rx = rx;
+  if (rx == NULL || sim.serial == NULL || sim.serial_thread)
+    return;
+  sim.serial_thread = 1;
+  pthread_t thread;
+  pthread_create(&thread, NULL, serial_thread, NULL);
+  pthread_detach(thread);
+}
+
+
+void mbed_sim_serial_detach(mbed::FunctionPointer *rx) {
+
+  if (sim.serial_rx == rx)
+    sim.serial_rx = NULL;
+}
+
+
+// --- Ticker ---
+
+static void *ticker_thread(void *arg) {
+
+  mbed_sim_ticker_t *t = (mbed_sim_ticker_t *) arg;
+  uint64_t next = mbed_sim_time_us() + t->period;
+  in_ticker = 1;
+
+  pthread_mutex_lock(&t->mutex);
+  while (t->active) {
+    if (sim.speed > 0) {
+      struct timespec ts = realtime_of(next);
+      if (pthread_cond_timedwait(&t->cond, &t->mutex, &ts) != ETIMEDOUT)
+        continue; // stopped
+    } else {
+      clock_advance_to(next * 1000);
+    }
+    pthread_mutex_unlock(&t->mutex);
+    t->fn->call();
+    __sync_fetch_and_add(&sim.ticks, 1);
+    if (sim.speed == 0)
+      sched_yield();
+    next += t->period;
+    pthread_mutex_lock(&t->mutex);
+  }
+  int orphan = t->orphan;
+  pthread_mutex_unlock(&t->mutex);
+
+  __sync_fetch_and_sub(&sim.tickers, 1);
+  clock_advance_to(0); // the waiting threads advance the clock themselves
+
+  if (orphan) {
+    pthread_cond_destroy(&t->cond);
+    pthread_mutex_destroy(&t->mutex);
+    delete t;
+  }
+  return NULL;
+}
+
+
+mbed_sim_ticker_t *mbed_sim_ticker_start(mbed::FunctionPointer *fn,
+                                         uint32_t period_us) {
+
+  sim_init_once();
+  mbed_sim_ticker_t *t = new mbed_sim_ticker_t;
+  t->fn = fn;
+  t->period = (period_us > 0)? period_us : 1;
+  t->active = 1;
+  t->orphan = 0;
+  __sync_fetch_and_add(&sim.tickers, 1);
+  pthread_mutex_init(&t->mutex, NULL);
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&t->cond, &attr);
+  pthread_condattr_destroy(&attr);
+  pthread_create(&t->thread, NULL, ticker_thread, t);
+  return t;
+}
+
+
+void mbed_sim_ticker_stop(mbed_sim_ticker_t *t) {
+
+  pthread_mutex_lock(&t->mutex);
+  t->active = 0;
+  int self = pthread_equal(t->thread, pthread_self());
+  if (self) {
+    t->orphan = 1;
+    pthread_detach(t->thread);
+  }
+  pthread_cond_signal(&t->cond);
+  pthread_mutex_unlock(&t->mutex);
+
+  if (!self) {
+    pthread_join(t->thread, NULL);
+    pthread_cond_destroy(&t->cond);
+    pthread_mutex_destroy(&t->mutex);
+    delete t;
+  }
+}
+
+
+// --- Local filesystem ---
+
+void mbed_sim_mount(const char *name) {
+
+  sim_init_once();
+  if (sim.mounts < SIM_MOUNTS) {
+    strncpy(sim.mount[sim.mounts], name, sizeof(sim.mount[0]) - 1);
+    sim.mounts++;
+  }
+  mkdir(sim.local, 0777);
+}
+
+
+extern "C" FILE *__wrap_fopen(const char *path, const char *mode) {
+
+  sim_init_once();
+  for (int i = 0; i < sim.mounts; i++) {
+    size_t n = strlen(sim.mount[i]);
+    if (path[0] == '/' && !strncmp(path + 1, sim.mount[i], n) &&
+        path[n + 1] == '/') {
+      char local[512];
+      snprintf(local, sizeof(local), "%s/%s", sim.local, path + n + 2);
+      return __real_fopen(local, mode);
+    }
+  }
+  return __real_fopen(path, mode);
+}
+
+
+// --- Exit ---
+
+void mbed_sim_atexit(void (*fn)(void)) {
+
+  sim_init_once();
+  pthread_mutex_lock(&sim.exit_mutex);
+  if (sim.atexits < SIM_ATEXIT)
+    sim.atexit[sim.atexits++] = fn;
+  pthread_mutex_unlock(&sim.exit_mutex);
+}
+
+
+// The other threads are still running, so the static objects are not
+// destroyed
+void mbed_sim_exit(int status) {
+
+  run_atexit();
+  fflush(NULL);
+  _exit(status);
+}
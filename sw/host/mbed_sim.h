@@ -0,0 +1,165 @@
+/* mbed_sim.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the declarations of the simulator behind the
+ * host HAL (mbed.h, rtos.h): the simulated clock, the pin table, the I2C and
+ * SPI buses with their device models, the DMA to the SPI bus, the serial
+ * port, the tickers and the local filesystem.
+ *
+ * The simulator is configured by environment variables:
+ *
+ *  Variable           | Meaning                                  | Default
+ *  ---------------------------------------------------------------------------
+ *  MBED_SIM_SPEED     | clock speed, x real time, 0 = virtual    | 1
+ *  MBED_SIM_DURATION  | exit after this many simulated seconds   | 0 (never)
+ *  MBED_SIM_PINS      | input levels, e.g. "p18=1,p16=0"         |
+ *  MBED_SIM_SERIAL    | file or FIFO read by the serial port RX  |
+ *  MBED_SIM_LOCAL     | directory of the LocalFileSystem         | local
+ *
+ * and the device models of the board by their own (see board_sim.cpp).
+ *
+ * The virtual clock (MBED_SIM_SPEED=0) advances when a ticker fires, when a
+ * thread waits and by the duration of every bus transfer at the configured
+ * bus frequency, so the program runs as fast as the host allows while the
+ * signals it samples keep their simulated timing. While a ticker runs, a
+ * waiting thread sleeps until the ticker moves the clock past its wake-up
+ * time, otherwise the wait advances the clock itself, i.e. the waits of
+ * concurrent threads add up.
+ *
+ * On exit, the simulated and the elapsed time and the bus transfer counts
+ * are printed to stderr.
+ *
+ * Dependencies:
+ *  "mbed.h", ANSI C99
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_HOST_MBED_SIM_H_
+#define __CPP98_HOST_MBED_SIM_H_
+
+namespace mbed {
+class FunctionPointer;
+}
+
+// Ticker thread
+struct mbed_sim_ticker_t;
+
+
+// Simulated time since the start of the program (us)
+uint64_t mbed_sim_time_us(void);
+
+// Sleep for us of simulated time (advances the virtual clock)
+void mbed_sim_sleep_us(uint64_t us);
+
+// Time spent by a transfer, advances the virtual clock only (ns)
+void mbed_sim_busy_ns(uint64_t ns);
+
+// Real time clock, time() returns t plus the simulated time since the call
+void mbed_sim_set_time(time_t t);
+
+
+// Level of a pin, 0 for NC
+int mbed_sim_pin_read(PinName pin);
+
+// Drive a pin (outputs, device models)
+void mbed_sim_pin_write(PinName pin, int value);
+
+// Pull an input pin to value, unless its level is set by MBED_SIM_PINS
+void mbed_sim_pin_pull(PinName pin, int value);
+
+
+// I2C device model, attached to the bus by its 7-bit address
+class SimI2CDevice {
+public:
+  virtual ~SimI2CDevice() {}
+
+  // Write transaction of length bytes, returns 0 on ACK
+  virtual int write(const char *data, int length) = 0;
+
+  // Read transaction of length bytes, returns 0 on ACK
+  virtual int read(char *data, int length) = 0;
+};
+
+void mbed_sim_i2c_attach(
+  int address,             // 7-bit address.
+  SimI2CDevice *device);   // device model, or NULL to detach.
+
+// 1 if a device is attached to the 7-bit address
+int mbed_sim_i2c_present(int address);
+
+// Transactions of the I2C master, return 0 on ACK (non-zero if no device is
+// attached to the 7-bit address)
+int mbed_sim_i2c_read(int address, char *data, int length, int hz);
+int mbed_sim_i2c_write(int address, const char *data, int length, int hz);
+
+
+// SPI device model, attached to the bus by its clock pin
+class SimSPIDevice {
+public:
+  virtual ~SimSPIDevice() {}
+
+  // Transfer of one frame of bits, returns the MISO frame, or -1 if the
+  // device is not selected
+  virtual int write(int value, int bits) = 0;
+};
+
+void mbed_sim_spi_attach(
+  PinName sclk,            // clock pin of the bus.
+  SimSPIDevice *device);   // device model.
+
+// Transfer of the SPI master, returns the MISO frame (0xFF if no device
+// answers)
+int mbed_sim_spi_write(PinName sclk, int value, int bits, int hz);
+
+// DMA transfer of length bytes to the SPI master, like the GPDMA of the
+// target: the bytes are written by the DMA thread while the caller goes on,
+// and done is called from the DMA thread, like the DMA interrupt, once the
+// last byte is out. Returns 0, or -1 if the previous transfer is not done.
+int mbed_sim_spi_dma(
+  PinName sclk,              // clock pin of the bus.
+  const unsigned char *data, // bytes, read during the transfer.
+  int length,                // number of bytes.
+  int hz,                    // bus frequency (Hz).
+  mbed::FunctionPointer *done); // callback, or NULL.
+
+
+// Serial port RX, getc() blocks until a byte is available
+int mbed_sim_serial_readable(void);
+int mbed_sim_serial_getc(void);
+
+// RX callback, called by the RX thread while data is available
+void mbed_sim_serial_attach(mbed::FunctionPointer *rx);
+void mbed_sim_serial_detach(mbed::FunctionPointer *rx);
+
+
+// Periodic call of fn, every period_us of simulated time, by a new thread
+mbed_sim_ticker_t *mbed_sim_ticker_start(
+  mbed::FunctionPointer *fn, // callback.
+  uint32_t period_us);       // period (us).
+
+// Stop the thread of a ticker (may be called by its callback)
+void mbed_sim_ticker_stop(mbed_sim_ticker_t *ticker);
+
+
+// Mount a LocalFileSystem, fopen("/<name>/<file>") opens <MBED_SIM_LOCAL>/
+// <file> (fopen is wrapped at link time, see CMakeLists.txt)
+void mbed_sim_mount(const char *name);
+
+
+// Function called on exit (e.g. by device models to save their state)
+void mbed_sim_atexit(void (*fn)(void));
+
+// Exit the simulation from any thread
+void mbed_sim_exit(int status);
+
+
+#endif // __CPP98_HOST_MBED_SIM_H_
@@ -0,0 +1,347 @@
+/* rtos.h
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This header file contains the simulated mbed RTOS of the host build, which
+ * is included instead of mbed-rtos/rtos/rtos.h. The classes have the names
+ * and signatures of the mbed RTOS [2] and are backed by POSIX threads:
+ *
+ *  Class             | Backed by
+ *  ---------------------------------------------------------------------------
+ *  Thread            | pthread, signal flags under a mutex/condition pair
+ *  Mutex             | recursive pthread mutex
+ *  Semaphore         | counter under a mutex/condition pair
+ *  Queue, Mail       | ring buffer of queue_sz messages (header only)
+ *  MemoryPool        | free list of pool_sz blocks (header only)
+ *
+ * Thread priorities are recorded but not applied. Thread::wait() sleeps on
+ * the simulated clock (see mbed_sim.h), the timeouts of the blocking calls
+ * are measured in real time.
+ *
+ * Dependencies:
+ *  "mbed.h", POSIX.1-2001
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *  [2] ARM Ltd., "mbed RTOS," headers of sw/mbed-rtos, 2014.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#ifndef __CPP98_HOST_RTOS_H_
+#define __CPP98_HOST_RTOS_H_
+
+#include "mbed.h"
+#include <pthread.h>
+
+// Timeout value of the blocking calls to wait forever
+#define osWaitForever 0xFFFFFFFF
+
+// Stack size of the threads (bytes), the host threads use the default stack
+#define DEFAULT_STACK_SIZE (WORDS_STACK_SIZE*4)
+#define WORDS_STACK_SIZE   512
+
+// Thread priorities (CMSIS-RTOS)
+typedef enum {
+  osPriorityIdle        = -3,
+  osPriorityLow         = -2,
+  osPriorityBelowNormal = -1,
+  osPriorityNormal      =  0,
+  osPriorityAboveNormal = +1,
+  osPriorityHigh        = +2,
+  osPriorityRealtime    = +3,
+  osPriorityError       =  0x84
+} osPriority;
+
+// Status codes (CMSIS-RTOS)
+typedef enum {
+  osOK                   = 0,
+  osEventSignal          = 0x08,
+  osEventMessage         = 0x10,
+  osEventMail            = 0x20,
+  osEventTimeout         = 0x40,
+  osErrorParameter       = 0x80,
+  osErrorResource        = 0x81,
+  osErrorTimeoutResource = 0xC1,
+  osErrorISR             = 0x82,
+  osErrorISRRecursive    = 0x83,
+  osErrorPriority        = 0x84,
+  osErrorNoMemory        = 0x85,
+  osErrorValue           = 0x86,
+  osErrorOS              = 0xFF,
+  os_status_reserved     = 0x7FFFFFFF
+} osStatus;
+
+// Event (CMSIS-RTOS)
+typedef struct {
+  osStatus status;
+  union {
+    uint32_t v;
+    void *p;
+    int32_t signals;
+  } value;
+  union {
+    void *mail_id;
+    void *message_id;
+  } def;
+} osEvent;
+
+// Thread state of the simulator
+struct mbed_sim_thread_t;
+
+typedef mbed_sim_thread_t *osThreadId;
+
+namespace rtos {
+
+
+// Lock of a mutex/condition pair for the duration of a scope
+class SimLock {
+public:
+  SimLock(pthread_mutex_t *m) : _m(m) { pthread_mutex_lock(_m); }
+  ~SimLock() { pthread_mutex_unlock(_m); }
+private:
+  pthread_mutex_t *_m;
+};
+
+// Wait on c until the absolute deadline of millisec from now, returns 0 on
+// timeout (millisec = osWaitForever waits forever)
+int sim_cond_wait(pthread_cond_t *c, pthread_mutex_t *m, uint32_t millisec,
+                  const struct timespec *deadline);
+
+// Absolute deadline of millisec from now, for sim_cond_wait()
+void sim_deadline(struct timespec *deadline, uint32_t millisec);
+
+// Condition variable on the monotonic clock
+void sim_cond_init(pthread_cond_t *c);
+
+
+class Thread {
+public:
+
+  Thread(void (*task)(void const *argument), void *argument = NULL,
+         osPriority priority = osPriorityNormal,
+         uint32_t stack_size = DEFAULT_STACK_SIZE,
+         unsigned char *stack_pointer = NULL);
+
+  osStatus terminate();
+
+  osStatus set_priority(osPriority priority);
+
+  osPriority get_priority();
+
+  int32_t signal_set(int32_t signals);
+
+  enum State {
+    Inactive,
+    Ready,
+    Running,
+    WaitingDelay,
+    WaitingInterval,
+    WaitingOr,
+    WaitingAnd,
+    WaitingSemaphore,
+    WaitingMailbox,
+    WaitingMutex
+  };
+
+  State get_state();
+
+  static osEvent signal_wait(int32_t signals, uint32_t millisec = osWaitForever);
+
+  static osStatus wait(uint32_t millisec);
+
+  static osStatus yield();
+
+  static osThreadId gettid();
+
+  virtual ~Thread();
+
+private:
+  osThreadId _tid;
+};
+
+
+class Mutex {
+public:
+
+  Mutex();
+
+  osStatus lock(uint32_t millisec = osWaitForever);
+
+  bool trylock();
+
+  osStatus unlock();
+
+  ~Mutex();
+
+private:
+  pthread_mutex_t _mutex;
+};
+
+
+class Semaphore {
+public:
+
+  Semaphore(int32_t count);
+
+  int32_t wait(uint32_t millisec = osWaitForever);
+
+  osStatus release(void);
+
+  ~Semaphore();
+
+private:
+  int32_t _count;
+  pthread_mutex_t _mutex;
+  pthread_cond_t _cond;
+};
+
+
+// Ring buffer of queue_sz messages (32-bit values or pointers) with blocking
+// put and get
+template<typename T, uint32_t queue_sz>
+class Queue {
+public:
+
+  Queue() : _head(0), _count(0) {
+    pthread_mutex_init(&_mutex, NULL);
+    sim_cond_init(&_cond);
+  }
+
+  osStatus put(T *data, uint32_t millisec = 0) {
+    SimLock lock(&_mutex);
+    struct timespec deadline;
+    sim_deadline(&deadline, millisec);
+    while (_count == queue_sz)
+      if (!sim_cond_wait(&_cond, &_mutex, millisec, &deadline))
+        return (millisec == 0)? osErrorResource : osErrorTimeoutResource;
+    _q[(_head + _count++) % queue_sz] = data;
+    pthread_cond_broadcast(&_cond);
+    return osOK;
+  }
+
+  osEvent get(uint32_t millisec = osWaitForever) {
+    SimLock lock(&_mutex);
+    osEvent e;
+    e.def.message_id = this;
+    struct timespec deadline;
+    sim_deadline(&deadline, millisec);
+    while (_count == 0)
+      if (!sim_cond_wait(&_cond, &_mutex, millisec, &deadline)) {
+        e.status = (millisec == 0)? osOK : osEventTimeout;
+        e.value.p = NULL;
+        return e;
+      }
+    e.status = osEventMessage;
+    e.value.p = (void *) _q[_head];
+    _head = (_head + 1) % queue_sz;
+    _count--;
+    pthread_cond_broadcast(&_cond);
+    return e;
+  }
+
+  ~Queue() {
+    pthread_cond_destroy(&_cond);
+    pthread_mutex_destroy(&_mutex);
+  }
+
+private:
+  T *_q[queue_sz];
+  uint32_t _head, _count;
+  pthread_mutex_t _mutex;
+  pthread_cond_t _cond;
+};
+
+
+// Pool of pool_sz blocks of type T
+template<typename T, uint32_t pool_sz>
+class MemoryPool {
+public:
+
+  MemoryPool() : _free(0) {
+    pthread_mutex_init(&_mutex, NULL);
+    for (uint32_t i = 0; i < pool_sz; i++)
+      _next[i] = i + 1;
+  }
+
+  T *alloc(void) {
+    SimLock lock(&_mutex);
+    if (_free == pool_sz)
+      return NULL;
+    uint32_t i = _free;
+    _free = _next[i];
+    return &_pool[i];
+  }
+
+  T *calloc(void) {
+    T *block = alloc();
+    if (block != NULL)
+      memset((void *) block, 0, sizeof(T));
+    return block;
+  }
+
+  osStatus free(T *block) {
+    if (block < _pool || block >= _pool + pool_sz)
+      return osErrorValue;
+    SimLock lock(&_mutex);
+    uint32_t i = block - _pool;
+    _next[i] = _free;
+    _free = i;
+    return osOK;
+  }
+
+  ~MemoryPool() {
+    pthread_mutex_destroy(&_mutex);
+  }
+
+private:
+  T _pool[pool_sz];
+  uint32_t _next[pool_sz]; // free list
+  uint32_t _free;          // first free block, pool_sz if none
+  pthread_mutex_t _mutex;
+};
+
+
+// Queue of queue_sz blocks of type T, allocated from a MemoryPool
+template<typename T, uint32_t queue_sz>
+class Mail {
+public:
+
+  T *alloc(uint32_t millisec = 0) {
+    return _pool.alloc();
+  }
+
+  T *calloc(uint32_t millisec = 0) {
+    return _pool.calloc();
+  }
+
+  osStatus put(T *mptr) {
+    return _queue.put(mptr);
+  }
+
+  osEvent get(uint32_t millisec = osWaitForever) {
+    osEvent e = _queue.get(millisec);
+    if (e.status == osEventMessage)
+      e.status = osEventMail;
+    return e;
+  }
+
+  osStatus free(T *mptr) {
+    return _pool.free(mptr);
+  }
+
+private:
+  Queue<T, queue_sz> _queue;
+  MemoryPool<T, queue_sz> _pool;
+};
+
+} // namespace rtos
+
+using namespace rtos;
+
+
+#endif // __CPP98_HOST_RTOS_H_
@@ -0,0 +1,315 @@
+/* rtos_sim.cpp
+ *
+ * Author: Petros Fountas
+ * C++98 compliant [1]
+ * Created on Fri 16 Oct 2026
+ *
+ * This source file contains the implementation of the simulated mbed RTOS
+ * threads and synchronisation objects on POSIX threads.
+ *
+ * Dependencies:
+ *  "rtos.h", POSIX.1-2001
+ *
+ * References:
+ *  [1] ISO/IEC, "Programming Languages—C++ (ISO/IEC 14882:1998)," Geneva,
+ *      Switzerland: ISO, 1998.
+ *
+ * Last modified on Fri 16 Oct 2026
+ *
+ * Copyright by Petros Fountas. All rights reserved.
+ */
+#include "rtos.h"
+#include <errno.h>
+#include <sched.h>
+
+// Thread state of the simulator
+struct mbed_sim_thread_t {
+  pthread_t thread;
+  void (*task)(void const *argument);
+  void *argument;
+  osPriority priority;
+  Thread::State state;
+  int32_t signals;       // signal flags
+  pthread_mutex_t mutex; // guards signals and state
+  pthread_cond_t cond;   // signalled by signal_set()
+};
+
+// State of the calling thread, created on first use for threads that are
+// not rtos::Thread (e.g. the main thread)
+static __thread mbed_sim_thread_t *current = NULL;
+
+
+namespace rtos {
+
+void sim_cond_init(pthread_cond_t *c) {
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(c, &attr);
+  pthread_condattr_destroy(&attr);
+}
+
+
+void sim_deadline(struct timespec *deadline, uint32_t millisec) {
+
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+  if (millisec == osWaitForever)
+    return;
+  deadline->tv_sec += millisec / 1000;
+  deadline->tv_nsec += (millisec % 1000) * 1000000L;
+  if (deadline->tv_nsec >= 1000000000L) {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+
+int sim_cond_wait(pthread_cond_t *c, pthread_mutex_t *m, uint32_t millisec,
+                  const struct timespec *deadline) {
+
+  if (millisec == osWaitForever) {
+    pthread_cond_wait(c, m);
+    return 1;
+  }
+  if (millisec == 0)
+    return 0;
+  return pthread_cond_timedwait(c, m, deadline) != ETIMEDOUT;
+}
+
+} // namespace rtos
+
+
+static mbed_sim_thread_t *thread_new(void) {
+
+  mbed_sim_thread_t *t = new mbed_sim_thread_t;
+  t->thread = pthread_self();
+  t->task = NULL;
+  t->argument = NULL;
+  t->priority = osPriorityNormal;
+  t->state = Thread::Running;
+  t->signals = 0;
+  pthread_mutex_init(&t->mutex, NULL);
+  sim_cond_init(&t->cond);
+  return t;
+}
+
+
+static void *thread_main(void *arg) {
+
+  mbed_sim_thread_t *t = (mbed_sim_thread_t *) arg;
+  current = t;
+  t->task(t->argument);
+  SimLock lock(&t->mutex);
+  t->state = Thread::Inactive;
+  return NULL;
+}
+
+
+Thread::Thread(void (*task)(void const *argument), void *argument,
+               osPriority priority, uint32_t stack_size,
+               unsigned char *stack_pointer) {
+
+  _tid = thread_new();
+  _tid->task = task;
+  _tid->argument = argument;
+  _tid->priority = priority;
+  _tid->state = Ready;
+  if (pthread_create(&_tid->thread, NULL, thread_main, _tid) != 0)
+    _tid->state = Inactive;
+}
+
+
+osStatus Thread::terminate() {
+
+  {
+    SimLock lock(&_tid->mutex);
+    if (_tid->state == Inactive && _tid->task == NULL)
+      return osErrorResource;
+  }
+  if (pthread_equal(_tid->thread, pthread_self()))
+    pthread_exit(NULL);
+  pthread_cancel(_tid->thread);
+  pthread_join(_tid->thread, NULL);
+  _tid->task = NULL; // joined
+  _tid->state = Inactive;
+  return osOK;
+}
+
+
+osStatus Thread::set_priority(osPriority priority) {
+
+  _tid->priority = priority;
+  return osOK;
+}
+
+
+osPriority Thread::get_priority() {
+
+  return _tid->priority;
+}
+
+
+int32_t Thread::signal_set(int32_t signals) {
+
+  SimLock lock(&_tid->mutex);
+  int32_t previous = _tid->signals;
+  _tid->signals |= signals;
+  pthread_cond_broadcast(&_tid->cond);
+  return previous;
+}
+
+
+Thread::State Thread::get_state() {
+
+  SimLock lock(&_tid->mutex);
+  return _tid->state;
+}
+
+
+// Wait until all the signals are set (any signal if signals is 0), and
+// clear them
+osEvent Thread::signal_wait(int32_t signals, uint32_t millisec) {
+
+  mbed_sim_thread_t *t = gettid();
+  SimLock lock(&t->mutex);
+  struct timespec deadline;
+  sim_deadline(&deadline, millisec);
+
+  osEvent e;
+  e.def.message_id = NULL;
+  for (;;) {
+    int32_t set = (signals == 0)? t->signals : (t->signals & signals);
+    if (set != 0 && (signals == 0 || set == signals)) {
+      e.status = osEventSignal;
+      e.value.signals = t->signals;
+      t->signals &= ~set;
+      break;
+    }
+    t->state = WaitingAnd;
+    int woken = sim_cond_wait(&t->cond, &t->mutex, millisec, &deadline);
+    t->state = Running;
+    if (!woken) {
+      e.status = (millisec == 0)? osOK : osEventTimeout;
+      e.value.signals = 0;
+      break;
+    }
+  }
+  return e;
+}
+
+
+osStatus Thread::wait(uint32_t millisec) {
+
+  mbed_sim_sleep_us((uint64_t) millisec * 1000);
+  return osEventTimeout;
+}
+
+
+osStatus Thread::yield() {
+
+  sched_yield();
+  return osOK;
+}
+
+
+osThreadId Thread::gettid() {
+
+  if (current == NULL)
+    current = thread_new();
+  return current;
+}
+
+
+Thread::~Thread() {
+
+  terminate();
+  pthread_cond_destroy(&_tid->cond);
+  pthread_mutex_destroy(&_tid->mutex);
+  delete _tid;
+}
+
+
+Mutex::Mutex() {
+
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&_mutex, &attr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+
+osStatus Mutex::lock(uint32_t millisec) {
+
+  if (millisec == osWaitForever)
+    return pthread_mutex_lock(&_mutex)? osErrorOS : osOK;
+  if (millisec == 0)
+    return trylock()? osOK : osErrorResource;
+
+  struct timespec deadline; // the mutex timeout is on the realtime clock
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += millisec / 1000;
+  deadline.tv_nsec += (millisec % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return pthread_mutex_timedlock(&_mutex, &deadline)?
+         osErrorTimeoutResource : osOK;
+}
+
+
+bool Mutex::trylock() {
+
+  return pthread_mutex_trylock(&_mutex) == 0;
+}
+
+
+osStatus Mutex::unlock() {
+
+  return pthread_mutex_unlock(&_mutex)? osErrorResource : osOK;
+}
+
+
+Mutex::~Mutex() {
+
+  pthread_mutex_destroy(&_mutex);
+}
+
+
+Semaphore::Semaphore(int32_t count) : _count(count) {
+
+  pthread_mutex_init(&_mutex, NULL);
+  sim_cond_init(&_cond);
+}
+
+
+// Returns the number of available tokens before the wait took one, or 0 on
+// timeout
+int32_t Semaphore::wait(uint32_t millisec) {
+
+  SimLock lock(&_mutex);
+  struct timespec deadline;
+  sim_deadline(&deadline, millisec);
+  while (_count <= 0)
+    if (!sim_cond_wait(&_cond, &_mutex, millisec, &deadline))
+      return 0;
+  return _count--;
+}
+
+
+osStatus Semaphore::release(void) {
+
+  SimLock lock(&_mutex);
+  _count++;
+  pthread_cond_signal(&_cond);
+  return osOK;
+}
+
+
+Semaphore::~Semaphore() {
+
+  pthread_cond_destroy(&_cond);
+  pthread_mutex_destroy(&_mutex);
+}
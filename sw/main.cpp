@@ -3,6 +3,8 @@
 #include "N5110.h"
 #include "TMP102.h"
 #include "dsp.h"
+#include "Profiler.h"
+#include "Plot.h"
 
 // On-boards LEDs for visual feedback
 BusOut leds(LED4, LED3, LED2, LED1);
@@ -32,116 +34,241 @@ N5110 display(p7, p8, p9, p10, p11, p13, p21); // LCD 84x48
 #define DISP_HEIGHT 48
 bool dirty; // screen redraw flag
 
+// Profiling of the acquisition period (A and B together dump it to serial)
+ProfileTimer tempTimer("tmp.temp");
+ProfileTimer dftTimer("computeDFT");
+ProfileTimer psdTimer("computePSD");
+ProfileTimer refreshTimer("display.refresh");
+ProfileTimer redrawTimer("redraw");
+ProfileTimer rxIsrTimer("serial ISR");
+
 // DFT
 #define N  64 	// samples
 #define Fs 1000 // Sampling frequency
-float x[N];        // signal
-complex_t cx[N];   // complex signal
-complex_t X[N];    // DFT
+float x[N];        // signal of the latest DFT
+float tmp_x[N];    // block of the TMP102 signal being acquired
+float rx_x[N];     // frame of the Matlab signal being received
+#ifdef DSP_FIXED_POINT
+complex_q15_t X[N];// DFT (Q15, value is X[k]･2^Xe)
+int Xe;            // DFT block exponent
+#else
+complex_t X[N/2+1];// DFT (unique bins of a real signal)
+#endif
+#ifdef DSP_SLIDING_DFT
+#ifdef DSP_FIXED_POINT
+#error "The sliding DFT is only available in the float pipeline"
+#endif
+sdft_t sdft;           // sliding DFT of the temperature signal
+float sdft_x[N];       // sliding DFT window
+complex_t sdft_X[N/2+1]; // sliding DFT bins
+#endif
 float spectrum[N]; // Spectrum
 float Pxx[N];      // PSD
 
+// The two sources compute their spectra in their own threads, into the same
+// signal, DFT, spectrum and PSD, which the controller draws
+Mutex dsp_mutex;
+
+// Window applied to the DFT blocks and the PSD segments
+#define WINDOW_TYPE WINDOW_HANN
+window_t win;
+float win_w[N];    // window coefficients
+
+// Welch PSD estimators (segments of N samples), one per signal source
+#define PSD_OVERLAP  WELCH_OVERLAP_50(N) // overlap of consecutive segments
+#define PSD_SEGMENTS 16                  // segments averaged before forgetting
+welch_t psd_tmp;   // TMP102 signal
+welch_t psd_rx;    // Matlab signal
+#ifndef DSP_FIXED_POINT
+float psd_tmp_work[WELCH_WORK_SIZE(N)];
+float psd_rx_work[WELCH_WORK_SIZE(N)];
+float P[N/2+1];    // averaged periodogram
+#endif
+
 // Control state machine
 int state, pstate;
 #define DISP_SIG 1
 #define DISP_DFT 2
 #define DISP_PSD 3
 
-// function to plot line on display
-void plotLine(N5110 *display, float points[], int npoints) {
+// plots of the spectrum and of the periodogram, each keeps its own scale
+Plot dftPlot(&display), psdPlot(&display);
+
+// Temperature history (strip chart below the temperature), the samples of
+// tmp_daq are aggregated to the minimum and maximum of each column
+#define DAQ_HZ           8  // acquisition rate of tmp_daq (maximum)
+#define HISTORY_S_PER_PX 1  // seconds per column of the chart
+dsp::ring_buffer<float, 64> history; // tmp_daq to the controller
+volatile unsigned history_dropped = 0; // samples dropped while it is full
+Plot historyPlot(&display, 0, 8, DISP_WIDTH, DISP_HEIGHT - 8);
+float temperature; // latest sample of the history
+
+// function to plot line on display, any number of points (decimated to the
+// width of the display)
+void plotLine(Plot *plot, float points[], int npoints) {
+
+	dsp_mutex.lock(); // the points are copied, the threads may then update them
+	plot->setData(points,npoints);
+	dsp_mutex.unlock();
+	plot->draw(); // autoscaled, with tick marks and labels
+
+	// refresh display by DMA, the next frame is drawn during the transfer
+	ProfileScope scope(&refreshTimer);
+    display.refreshAsync();
+}
 
-	// find max(point) and min(point)
-	float max, min;
-	min = max = 0;
-	for (int n = 0; n < npoints; n++) {
-		max = (points[n] > max) ? points[n] : max;
-		min = (points[n] < min) ? points[n] : min;
-	}
+// function to show the temperature and its history, the chart sweeps so that
+// only its new columns are drawn, unless the screen is entered
+void plotHistory(bool enter) {
 
-	// Y-axes
-	float zero_point = (0-min)/(max-min); // normalise to [0..1]
-	float zero_h = (DISP_HEIGHT-1) - int(zero_point*(DISP_HEIGHT-1)); // px
-	display->setPixel(0,zero_h); // set pixel
-	display->setPixel(1,zero_h); // set pixel
-	for (int h = 0; h < DISP_HEIGHT; h++) {
-		display->setPixel(2,h); // set pixel
-	}
+	char phrase[15]; // 14 characters per line (84 px)
 
-	// normalise points to screent height
-	for (int n = 0; n < npoints; n++) {
-		float norm_point = (points[n]-min)/(max-min); // normalise to [0..1]
-		float h = (DISP_HEIGHT-1) - int(norm_point*(DISP_HEIGHT-1)); // px
-		display->setPixel(n+3,h); // set pixel
-	}
+	if (enter)
+		historyPlot.draw();
+	else
+		historyPlot.update();
+	display.clearRect(0,0,DISP_WIDTH,8);
+	snprintf(phrase,sizeof(phrase),"Temp: %.2f C",temperature);
+	display.drawString(phrase,0,0); // print temperature
+
+	// refresh display by DMA, the changed columns only
+	ProfileScope scope(&refreshTimer);
+	display.refreshAsync();
+}
+
+#ifdef DSP_FIXED_POINT
+
+// Compute DFT (Q15), with the spectrum and the PSD
+// The Q15 build has no Welch averaging (it needs the float FFT), so there is
+// no computePSD(): Pxx is the periodogram of the last block, derived here
+// with the spectrum and timed with the DFT.
+void computeDFT() {
+
+	ProfileScope scope(&dftTimer);
 
-	// refresh display
-    display->refresh();
+	pipeline_dft_q15(spectrum, Pxx, X, &Xe, x, &win, N, Fs);
 }
 
+#else
+
 // Compute DFT
 void computeDFT() {
 
-	// convert signal to complex
-	for (int n = 0; n < N; n++) cx[n] = complex_num(x[n], 0);
+	ProfileScope scope(&dftTimer);
 
-	// init DFT output sequence
-	for (int n = 0; n < N; n++) X[n] = complex_num(0, 0); // init to 0
+	// DFT of the windowed signal, and its spectrum (DC component and AC
+	// alliases removed, the rest of the signal spread)
+	pipeline_dft(spectrum, X, x, &win, N);
+}
 
-	// compute DFT
-	dft(X, cx, N);
+#ifdef DSP_SLIDING_DFT
+// Compute DFT of the last N samples, sliding by one sample
+void computeSlidingDFT(float sample) {
 
-	// remove DC component and AC alliases, and spread the rest of the signal
-	for (int n = 0; n < N; n++)
-		spectrum[n] = 0;
-	for (int n = 0; n < floor(N / 2) - 1; n++) {
-		spectrum[2 * n] = complex_norm(X[n + 1]);
-		spectrum[2 * n + 1] =
-				(complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
-	}
+	ProfileScope scope(&dftTimer);
+
+	// update sliding DFT in O(N)
+	sdft_update(&sdft, sample);
+	for (int k = 0; k <= N / 2; k++) X[k] = sdft_X[k];
+
+	// the sliding DFT is not windowed
+	spectrum_psd(spectrum, NULL, X, N, 2.0f / N, 0);
 }
+#endif
 
 // Compute PSD
-void computePSD() {
-
-	// estimate Power Spectral Density (PSD)
-	for (int n = 0; n < N; n++) Pxx[n] = 0; // init to 0
-	for (int n = 0; n < floor(N / 2) - 1; n++) {
-		Pxx[2 * n] = 20 * log10(pow(complex_norm(X[n + 1]), 2));
-		float avg = (complex_norm(X[n + 2]) + complex_norm(X[n + 1])) / 2;
-		Pxx[2 * n + 1] = 20 * log10(pow(avg, 2));
-	}
+void computePSD(welch_t *psd) {
+
+	ProfileScope scope(&psdTimer);
+
+	// estimate Power Spectral Density (PSD) from the averaged periodogram
+	// |X|^2 of the source (Welch)
+	pipeline_psd(Pxx, P, psd, &win, N, Fs);
 }
 
+#endif
+
 union sample_union {
 	float f;
 	unsigned char b[4];
 } sample;
 
-// Serial DAQ
-void matlab_rx() {
+// Serial DAQ, the ISR only hands the received bytes over to the rx thread,
+// which assembles the frames of N samples and computes their spectra
+#define RX_RING_SIZE 512 // bytes, two frames of N samples
+#define RX_SIG       0x1 // bytes received
+dsp::ring_buffer<unsigned char, RX_RING_SIZE> rx_ring; // ISR to the rx thread
+volatile unsigned rx_dropped = 0; // bytes dropped while the rx thread is behind
+Thread *rx_worker = NULL;
 
-	// get data from Matlab
-	for (int n = 0; n < N; n++) {
-		x[n] = 0;
+// Serial RX interrupt
+void serial_rx() {
 
-		// read number octet by octet
-		sample.b[0] = (unsigned char) getc(); // b0
-		sample.b[1] = (unsigned char) getc(); // b1
-		sample.b[2] = (unsigned char) getc(); // b2
-		sample.b[3] = (unsigned char) getc(); // b3
+	ProfileScope scope(&rxIsrTimer);
 
-		// save sample
-		x[n] = sample.f;
+	while (serial.readable()) {
+		if (!rx_ring.push((unsigned char) getc()))
+			rx_dropped++; // full, drop the byte
 	}
+	if (rx_worker != NULL)
+		rx_worker->signal_set(RX_SIG);
+}
 
-	// DFT
-	computeDFT();
+// Matlab rx thread
+void matlab_rx(void const *args) {
 
-	// Periodogram
-	computePSD();
+	int byte = 0; // of the frame
+	unsigned dropped = rx_dropped; // drops seen
 
-	// flag screen to be redraw
-	dirty = 1;
+	while (1) {
+		Thread::signal_wait(RX_SIG); // wait for bytes
+
+		// drain the bytes of the ISR in place
+		uint32_t count;
+		const unsigned char *b;
+		while ((b = rx_ring.peek(&count)), count > 0) {
+			if (rx_dropped != dropped) {
+				// the bytes buffered so far precede the dropped ones, so the
+				// frame is discarded and restarts with the bytes that follow
+				dropped = rx_dropped;
+				byte = 0;
+				rx_ring.consume(count);
+				continue;
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				// read number octet by octet
+				sample.b[byte % 4] = b[i];
+				if (++byte % 4)
+					continue;
+
+				// save sample
+				int n = byte / 4 - 1;
+				rx_x[n] = sample.f;
+#ifndef DSP_FIXED_POINT
+				welch_push(&psd_rx, rx_x[n]);
+#endif
+				if (byte < 4 * N)
+					continue;
+				byte = 0;
+
+				dsp_mutex.lock();
+				memcpy(x, rx_x, sizeof(x));
+
+				// DFT
+				computeDFT();
+
+#ifndef DSP_FIXED_POINT
+				// Periodogram
+				computePSD(&psd_rx);
+#endif
+
+				// flag screen to be redraw
+				dirty = 1;
+				dsp_mutex.unlock();
+			}
+			rx_ring.consume(count);
+		}
+	}
 }
 
 // Temperature Data-Acquisition thread
@@ -155,9 +282,12 @@ void tmp_daq(void const *args) {
 		if (isLoggingOn) {
 			// if the file doesn't exist it is created, if it exists, data is appended to the end
 			leds = 0xf; // turn on LEDs for feedback
-			fp = fopen("/local/log.csv", "a"); // open 'log.csv' for appending
+			if (fp == NULL)
+				fp = fopen("/local/log.csv", "a"); // open 'log.csv' for appending
 		} else {
-			fclose(fp); // close file
+			if (fp != NULL)
+				fclose(fp); // close file
+			fp = NULL;
 			leds = 0x0; // turn off LEDs to signify file access has finished
 		}
 
@@ -165,8 +295,16 @@ void tmp_daq(void const *args) {
 		for (int n = 0; n < N; n++) {
 			float temp = 0;
 			// get temperature
-			tmp.temp(&temp);
-			avg += (x[n] = temp);
+			{
+				ProfileScope scope(&tempTimer);
+				tmp.temp(&temp);
+			}
+			avg += (tmp_x[n] = temp);
+			if (!history.push(temp))
+				history_dropped++;
+#ifndef DSP_FIXED_POINT
+			welch_push(&psd_tmp, temp);
+#endif
 
 			// format time into a string (time and date)
 			time_t seconds = time(NULL); // get current time
@@ -176,8 +314,20 @@ void tmp_daq(void const *args) {
 				fprintf(fp, "%s, %.2f\n", buffer, temp);
 			}
 
-			// 8Hz daq rate (maximum)
-			Thread::wait(0.125);
+#ifdef DSP_SLIDING_DFT
+			// DFT and Periodogram of the last N samples
+			dsp_mutex.lock();
+			x[n] = temp;
+			computeSlidingDFT(temp);
+			computePSD(&psd_tmp);
+
+			// flag screen to be redraw
+			dirty = 1;
+			dsp_mutex.unlock();
+#endif
+
+			// DAQ_HZ daq rate (maximum), the wait is in ms
+			Thread::wait(1000 / DAQ_HZ);
 
 			//wait(60);
 		}
@@ -190,14 +340,22 @@ void tmp_daq(void const *args) {
 		//sscanf(buffer,"%f",&avg);
 		//display.printString(buffer,65,0);
 
+#ifndef DSP_SLIDING_DFT
+		dsp_mutex.lock();
+		memcpy(x, tmp_x, sizeof(x));
+
 		// DFT
 		computeDFT();
 
+#ifndef DSP_FIXED_POINT
 		// Periodogram
-		computePSD();
+		computePSD(&psd_tmp);
+#endif
 
 		// flag screen to be redraw
 		dirty = 1;
+		dsp_mutex.unlock();
+#endif
 	}
 }
 
@@ -210,22 +368,51 @@ int main() {
 	enable = 0;
 	tmp.init(1);
 
+#ifdef DSP_SLIDING_DFT
+	// init sliding DFT
+	sdft_init(&sdft, sdft_x, sdft_X, N, SDFT_R);
+#endif
+
+	// init window
+	window_init(&win, win_w, WINDOW_TYPE, N, WINDOW_KAISER_BETA);
+
+#ifndef DSP_FIXED_POINT
+	// init PSD estimators
+	welch_init(&psd_tmp, psd_tmp_work, N, PSD_OVERLAP, win.w, PSD_SEGMENTS);
+	welch_init(&psd_rx, psd_rx_work, N, PSD_OVERLAP, win.w, PSD_SEGMENTS);
+#endif
+
 	// init LCD display
 	dirty = 0;
 	display.init();
 
+	// init temperature history
+	historyPlot.setSamplesPerColumn(HISTORY_S_PER_PX * DAQ_HZ);
+	historyPlot.setSweep(true);
+
 	// temperature daq thread
 	Thread thread(tmp_daq);
 
-	// matlab rx callback
-	serial.attach(&matlab_rx);
+	// matlab rx thread and callback
+	Thread rx_thread(matlab_rx);
+	rx_worker = &rx_thread;
+	serial.attach(&serial_rx);
 
 	// Controller
 	pstate = 0,state = DISP_SIG; // init control state machine
 	while(1) {
 
 		// Controls
-		if (sw) { // SW = 1 - Signal Analysis ...
+		if (!a_btn && !b_btn) {
+			// Buttons A and B together - dump the profile to serial, without
+			// the actions of the buttons alone (logging, screens)
+			ProfileTimer::dump(&serial);
+			printf("%-16s %8lu (bytes)\r\n", "display.spi", display.getSPIBytes());
+			printf("%-16s %8u (samples)\r\n", "history.dropped", history_dropped);
+			printf("%-16s %8u (bytes)\r\n", "serial.dropped", rx_dropped);
+			while (!a_btn && !b_btn)
+				wait_ms(10); // until released
+		} else if (sw) { // SW = 1 - Signal Analysis ...
 			if (!a_btn) // Button A - Spectrum display
 				state = DISP_DFT;
 			if (!b_btn) // Button B - Power Spectral Density display
@@ -238,24 +425,38 @@ int main() {
 				isLoggingOn = 0;
 		}
 
+		// Temperature history, kept on every screen
+		bool sampled = false;
+		float temp;
+		while (history.pop(&temp)) {
+			historyPlot.append(temp);
+			temperature = temp;
+			sampled = true;
+		}
+
 		// State decoder
-		char phrase[13];
-		if (dirty || pstate != state) {
-			display.clear(); // clear display
+		char phrase[15]; // 14 characters per line (84 px)
+		if (pstate == state && state == DISP_SIG) {
+			if (sampled) {
+				ProfileScope scope(&redrawTimer);
+				plotHistory(false); // new columns only
+			}
+		} else if (dirty || pstate != state) {
+			ProfileScope scope(&redrawTimer);
+			display.clearBuffer(); // clear buffer, the refresh sends the changes only
 
 			switch (state) {
 			case DISP_SIG:
-				sprintf(phrase,"Temp: %.2f C",x[0]);
-				display.printString(phrase,0,0); // print temperature
+				plotHistory(true); // Display temperature and its history
 				break;
 			case DISP_DFT:
-				plotLine(&display,spectrum,N); // Display Spectrum
+				plotLine(&dftPlot,spectrum,N); // Display Spectrum
 				break;
 			case DISP_PSD:
-				plotLine(&display,Pxx,N); // Display Periodogram
+				plotLine(&psdPlot,Pxx,N); // Display Periodogram
 				break;
 			default:
-				sprintf(phrase,"Temp: %.2f C",x[0]);
+				snprintf(phrase,sizeof(phrase),"Temp: %.2f C",x[0]);
 				display.printString(phrase,0,0); // print temperature
 				break;
 			}